@@ -0,0 +1,32 @@
+#!/bin/bash
+# Builds LicenseCore with each crypto backend (shared library, so dynamic
+# loading and relocation are included) and compares process startup latency
+# for a validate-once CLI run plus steady-state HMAC throughput.
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+REPO_ROOT="$SCRIPT_DIR"
+RUNS="${RUNS:-200}"
+
+for backend in OpenSSL Builtin; do
+    build_dir="$REPO_ROOT/build-backend-$backend"
+    cmake -S "$REPO_ROOT" -B "$build_dir" \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DLICENSECORE_BUILD_SHARED=ON \
+        -DLICENSECORE_BUILD_EXAMPLES=ON \
+        -DLICENSECORE_CRYPTO_BACKEND="$backend" > /dev/null
+    cmake --build "$build_dir" --target crypto_backend_benchmark -j > /dev/null
+
+    bench="$build_dir/examples/crypto_backend_benchmark"
+    echo "=== $backend ==="
+
+    start=$(date +%s%N)
+    for ((i = 0; i < RUNS; i++)); do
+        "$bench" --once
+    done
+    end=$(date +%s%N)
+    echo "  process start + validate + exit: $(( (end - start) / RUNS / 1000 )) us (mean of $RUNS runs)"
+
+    "$bench"
+done
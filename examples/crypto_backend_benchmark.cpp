@@ -0,0 +1,84 @@
+#include <license_core/license_manager.hpp>
+#include <license_core/hmac_validator.hpp>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <cstring>
+
+using namespace license_core;
+
+// Compares crypto backends (-DLICENSECORE_CRYPTO_BACKEND=OpenSSL|Builtin).
+// Run once per build: prints the cold "validate one license" latency and the
+// steady-state HMAC throughput. With --once it only performs the cold
+// validation, which is what benchmark_crypto_backends.sh times per process.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double micros_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+LicenseInfo sample_license(const std::string& hwid) {
+    LicenseInfo info;
+    info.user_id = "benchmark-user";
+    info.license_id = "lic-benchmark";
+    info.hardware_hash = hwid;
+    info.features = {"basic", "premium", "api"};
+    info.issued_at = std::chrono::system_clock::now();
+    info.expiry = info.issued_at + std::chrono::hours(24 * 365);
+    return info;
+}
+
+void report_throughput(const HMACValidator& validator, size_t size) {
+    std::string data(size, 'x');
+    const int iterations = size > 4096 ? 2000 : 200000;
+
+    unsigned sink = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink += validator.sign_raw(data)[0];
+    }
+    double total_us = micros_since(start);
+
+    double ns_per_op = total_us * 1000.0 / iterations;
+    double mb_per_s = static_cast<double>(size) * iterations / total_us;
+    std::cout << "  HMAC-SHA256 " << std::setw(6) << size << " B: "
+              << std::fixed << std::setprecision(1) << std::setw(9) << ns_per_op << " ns/op, "
+              << std::setw(8) << mb_per_s << " MB/s" << (sink == 0xFFFFFFFFu ? " " : "") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto start = Clock::now();
+    bool once = argc > 1 && std::strcmp(argv[1], "--once") == 0;
+
+    try {
+        // Cold path of a CLI tool: first key setup, first hash, first validation
+        LicenseManager manager("benchmark-secret-key-0123456789");
+        std::string license = manager.generate_license(sample_license(manager.get_current_hwid()));
+        bool valid = manager.load_and_validate(license).valid;
+        double cold_us = micros_since(start);
+
+        if (once) {
+            return valid ? 0 : 1;
+        }
+
+        std::cout << "Crypto backend: " << HMACValidator::crypto_backend() << std::endl;
+        std::cout << "  cold generate + validate: " << std::fixed << std::setprecision(1)
+                  << cold_us << " us" << std::endl;
+
+        HMACValidator validator("benchmark-secret-key-0123456789");
+        for (size_t size : {64, 335, 1024, 65536}) {
+            report_throughput(validator, size);
+        }
+        return valid ? 0 : 1;
+
+    } catch (const LicenseException& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
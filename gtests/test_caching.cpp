@@ -4,6 +4,7 @@
 #include <thread>
 #include <vector>
 #include <chrono>
+#include <iostream>
 
 using namespace license_core;
 using namespace license_core::testing;
@@ -328,3 +329,121 @@ TEST_F(CacheThreadSafetyTest, ConcurrentCacheClearing_IsThreadSafe) {
     std::string final_result = fingerprint_->get_fingerprint_safe();
     EXPECT_FALSE(final_result.empty()) << "Cache should be functional after concurrent access";
 }
+
+TEST_F(CacheThreadSafetyTest, CachingDisabled_CountsEveryMiss) {
+    // No cached fingerprint, but the stats are still shared between threads
+    HardwareConfig config;
+    config.enable_caching = false;
+    HardwareFingerprint uncached(config);
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&uncached]() {
+            for (int i = 0; i < CALLS_PER_THREAD; ++i) {
+                EXPECT_FALSE(uncached.get_fingerprint_safe().empty());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    auto stats = uncached.get_cache_stats();
+    EXPECT_EQ(stats.cache_hits, 0u);
+    EXPECT_EQ(stats.cache_misses, static_cast<size_t>(NUM_THREADS * CALLS_PER_THREAD));
+}
+
+// Validation result cache on LicenseManager
+class ValidationCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        manager_ = std::make_unique<LicenseManager>(DEFAULT_TEST_SECRET);
+        license_ = manager_->generate_license(TestUtils::CreateTestLicense(manager_->get_current_hwid()));
+
+        ValidationCacheConfig config;
+        config.enabled = true;
+        config.capacity = 4;
+        config.shards = 2;
+        manager_->set_validation_cache(config);
+    }
+
+    std::unique_ptr<LicenseManager> manager_;
+    std::string license_;
+};
+
+TEST_F(ValidationCacheTest, RepeatedLoad_HitsCache) {
+    auto first = manager_->load_and_validate(license_);
+    auto second = manager_->load_and_validate(license_);
+    EXPECT_TRUE(manager_->validate_license(license_, first.hardware_hash));
+
+    EXPECT_TRUE(second.valid);
+    EXPECT_EQ(second.license_id, first.license_id);
+    EXPECT_EQ(second.features, first.features);
+
+    auto stats = manager_->get_validation_cache_stats();
+    EXPECT_EQ(stats.cache_misses, 1u);
+    EXPECT_EQ(stats.cache_hits, 2u);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST_F(ValidationCacheTest, TamperedLicense_NeverServedFromCache) {
+    manager_->load_and_validate(license_);
+
+    std::string tampered = license_;
+    tampered.replace(tampered.find("feature1"), 8, "feature9");
+    EXPECT_THROW(manager_->load_and_validate(tampered), InvalidSignatureException);
+    EXPECT_EQ(manager_->get_validation_cache_stats().entries, 1u);
+}
+
+TEST_F(ValidationCacheTest, Flushed_OnKeyAndHardwareConfigChange) {
+    manager_->load_and_validate(license_);
+    manager_->add_key("next", "next-quarter-secret-key-0001");
+    EXPECT_EQ(manager_->get_validation_cache_stats().entries, 0u);
+
+    manager_->load_and_validate(license_);
+    manager_->set_hardware_config(HardwareConfig{});
+    EXPECT_EQ(manager_->get_validation_cache_stats().entries, 0u);
+
+    manager_->load_and_validate(license_);
+    manager_->clear_validation_cache();
+    EXPECT_EQ(manager_->get_validation_cache_stats().entries, 0u);
+    EXPECT_EQ(manager_->get_validation_cache_stats().cache_misses, 3u);
+}
+
+TEST_F(ValidationCacheTest, BoundedCapacity_EvictsLeastRecentlyUsed) {
+    auto hwid = manager_->get_current_hwid();
+    for (int i = 0; i < 10; ++i) {
+        manager_->load_and_validate(manager_->generate_license(TestUtils::CreateTestLicense(hwid)));
+    }
+
+    auto stats = manager_->get_validation_cache_stats();
+    EXPECT_LE(stats.entries, 4u);
+    EXPECT_GE(stats.evictions, 6u);
+
+    manager_->set_validation_cache(ValidationCacheConfig{});
+    manager_->load_and_validate(license_);
+    EXPECT_EQ(manager_->get_validation_cache_stats().cache_misses, 0u);
+}
+
+TEST_F(ValidationCacheTest, CacheHit_VersusFullValidation) {
+    LicenseManager uncached(DEFAULT_TEST_SECRET);
+    constexpr int ITERATIONS = 2000;
+
+    manager_->load_and_validate(license_);
+    uncached.load_and_validate(license_);
+
+    auto hit_time = TestUtils::MeasureTime([this]() {
+        for (int i = 0; i < ITERATIONS; ++i) {
+            manager_->load_and_validate(license_);
+        }
+    });
+    auto full_time = TestUtils::MeasureTime([&]() {
+        for (int i = 0; i < ITERATIONS; ++i) {
+            uncached.load_and_validate(license_);
+        }
+    });
+
+    std::cout << "load_and_validate: cached " << hit_time.count() * 1000.0 / ITERATIONS
+              << " ns, full " << full_time.count() * 1000.0 / ITERATIONS << " ns" << std::endl;
+    EXPECT_EQ(manager_->get_validation_cache_stats().cache_hits, static_cast<size_t>(ITERATIONS));
+}
@@ -0,0 +1,314 @@
+#include "test_utils.hpp"
+#include "license_core/ed25519_validator.hpp"
+#include "crypto/hmac_sha256.hpp"
+#include "crypto/sha256.hpp"
+#include "simd/cpu_features.hpp"
+#include "simd/hex.hpp"
+#include <gtest/gtest.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <sstream>
+
+using namespace license_core;
+using namespace license_core::testing;
+
+// Micro-benchmarks for the signing primitives on realistic license payloads.
+// Timings are printed for comparison only; nothing asserts on them, so the
+// suite stays stable on shared CI machines.
+class CryptoPerformanceTest : public ::testing::Test {
+protected:
+    static constexpr int WARMUP_ITERATIONS = 1000;
+    static constexpr int BENCHMARK_ITERATIONS = 20000;
+
+    void SetUp() override {
+        auto info = TestUtils::CreateTestLicense(std::string(64, 'a'));
+        info.features = {"basic", "premium", "analytics", "export", "api_access"};
+        payload_ = TestUtils::CreateCanonicalPayload(info);
+        validator_ = std::make_unique<HMACValidator>(DEFAULT_TEST_SECRET);
+        signature_ = validator_->sign(payload_);
+    }
+
+    static void Report(const std::string& name, double ns_per_call) {
+        std::cout << "  " << std::left << std::setw(40) << name
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << ns_per_call << " ns/call" << std::endl;
+    }
+
+    std::string payload_;
+    std::string signature_;
+    std::unique_ptr<HMACValidator> validator_;
+};
+
+TEST_F(CryptoPerformanceTest, PreparedKey_VersusOneShotHmac) {
+    const std::string key = DEFAULT_TEST_SECRET;
+
+    unsigned int sink = 0;
+
+    // Baseline: what sign() did before - one-shot HMAC() with full key setup
+    // per call, followed by the same hex encoding
+    auto one_shot = [&]() {
+        unsigned char mac[EVP_MAX_MD_SIZE];
+        unsigned int mac_len = 0;
+        HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()),
+             reinterpret_cast<const unsigned char*>(payload_.data()), payload_.size(),
+             mac, &mac_len);
+        std::stringstream ss;
+        ss << std::hex << std::setfill('0');
+        for (unsigned int i = 0; i < mac_len; ++i) {
+            ss << std::setw(2) << static_cast<unsigned int>(mac[i]);
+        }
+        sink += static_cast<unsigned char>(ss.str()[0]);
+    };
+    auto prepared = [&]() {
+        sink += static_cast<unsigned char>(validator_->sign(payload_)[0]);
+    };
+
+    for (int i = 0; i < WARMUP_ITERATIONS; ++i) {
+        one_shot();
+        prepared();
+    }
+
+    double one_shot_ns = TestUtils::MeasureNanosPerCall(one_shot, BENCHMARK_ITERATIONS);
+    double prepared_ns = TestUtils::MeasureNanosPerCall(prepared, BENCHMARK_ITERATIONS);
+
+    std::cout << "HMAC-SHA256 over " << payload_.size() << "-byte canonical license:" << std::endl;
+    Report("one-shot HMAC() + hex (before)", one_shot_ns);
+    Report("HMACValidator::sign (prepared key)", prepared_ns);
+    std::cout << "  speedup: " << std::setprecision(2) << one_shot_ns / prepared_ns << "x" << std::endl;
+
+    EXPECT_GT(payload_.size(), 300u);
+    EXPECT_NE(sink, 0xFFFFFFFFu);
+}
+
+TEST_F(CryptoPerformanceTest, BatchVerify_VersusScalarLoop) {
+    std::cout << "Batch HMAC verification of " << payload_.size() << "-byte licenses:" << std::endl;
+
+    for (size_t batch_size : {1, 8, 64, 4096}) {
+        std::vector<HMACValidator::BatchItem> items(batch_size, {payload_, signature_});
+        const int rounds = static_cast<int>(std::max<size_t>(1, 20000 / batch_size));
+
+        size_t verified = 0;
+        auto scalar = [&]() {
+            for (size_t i = 0; i < items.size(); ++i) {
+                verified += validator_->verify(payload_, signature_) ? 1 : 0;
+            }
+        };
+        auto batch = [&]() {
+            auto results = validator_->verify_batch(items);
+            verified += static_cast<size_t>(std::count(results.begin(), results.end(), true));
+        };
+
+        scalar();
+        batch();
+        double scalar_ns = TestUtils::MeasureNanosPerCall(scalar, rounds) / batch_size;
+        double batch_ns = TestUtils::MeasureNanosPerCall(batch, rounds) / batch_size;
+
+        std::cout << "  batch size " << batch_size << ":" << std::endl;
+        Report("verify() loop, per item", scalar_ns);
+        Report("verify_batch(), per item", batch_ns);
+
+        EXPECT_EQ(verified, batch_size * 2 * (rounds + 1));
+    }
+}
+
+TEST_F(CryptoPerformanceTest, Ed25519_VersusHmac) {
+    if (!Ed25519Validator::is_available()) {
+        GTEST_SKIP() << "Ed25519 needs the OpenSSL crypto backend";
+    }
+
+    auto pair = Ed25519Validator::generate_key_pair();
+    auto signer = Ed25519Validator::from_private_key(pair.private_key);
+    Ed25519Validator verifier(pair.public_key);
+    std::string ed_signature = signer.sign(payload_);
+
+    const int iterations = 5000;
+    constexpr size_t BATCH = 256;
+    std::vector<HMACValidator::BatchItem> hmac_items(BATCH, {payload_, signature_});
+    std::vector<Ed25519Validator::BatchItem> ed_items(BATCH, {payload_, ed_signature});
+
+    size_t verified = 0;
+    auto hmac_verify = [&]() { verified += validator_->verify(payload_, signature_) ? 1 : 0; };
+    auto ed_verify = [&]() { verified += verifier.verify(payload_, ed_signature) ? 1 : 0; };
+    auto hmac_batch = [&]() {
+        auto results = validator_->verify_batch(hmac_items);
+        verified += static_cast<size_t>(std::count(results.begin(), results.end(), true));
+    };
+    auto ed_batch = [&]() {
+        auto results = verifier.verify_batch(ed_items);
+        verified += static_cast<size_t>(std::count(results.begin(), results.end(), true));
+    };
+
+    double hmac_ns = TestUtils::MeasureNanosPerCall(hmac_verify, iterations);
+    double ed_ns = TestUtils::MeasureNanosPerCall(ed_verify, iterations);
+    double hmac_batch_ns = TestUtils::MeasureNanosPerCall(hmac_batch, iterations / 100) / BATCH;
+    double ed_batch_ns = TestUtils::MeasureNanosPerCall(ed_batch, iterations / 100) / BATCH;
+    double ed_sign_ns = TestUtils::MeasureNanosPerCall([&]() { verified += signer.sign(payload_).size(); },
+                                                       iterations / 5);
+
+    std::cout << "Signature verification of " << payload_.size() << "-byte licenses:" << std::endl;
+    Report("HMAC-SHA256 verify()", hmac_ns);
+    Report("Ed25519 verify()", ed_ns);
+    Report("HMAC-SHA256 verify_batch(), per item", hmac_batch_ns);
+    Report("Ed25519 verify_batch(), per item", ed_batch_ns);
+    Report("Ed25519 sign()", ed_sign_ns);
+    std::cout << "  Ed25519 verifications/s: " << std::setprecision(0) << 1e9 / ed_batch_ns << std::endl;
+
+    EXPECT_GE(verified, static_cast<size_t>(2 * iterations));
+}
+
+// Builtin backend primitives against OpenSSL, independent of the configured backend
+TEST_F(CryptoPerformanceTest, BuiltinBackend_VersusOpenSSL) {
+    crypto::HmacSha256Key key(DEFAULT_TEST_SECRET);
+    const std::string secret = DEFAULT_TEST_SECRET;
+
+    std::cout << "Builtin vs OpenSSL (configured backend: " << HMACValidator::crypto_backend() << "):" << std::endl;
+    for (size_t size : {64, 335, 1024, 65536}) {
+        std::string data = TestUtils::RandomString(size);
+        const int iterations = size > 4096 ? 500 : 20000;
+        unsigned sink = 0;
+
+        auto openssl_sha = [&]() {
+            unsigned char digest[SHA256_DIGEST_LENGTH];
+            SHA256(reinterpret_cast<const unsigned char*>(data.data()), data.size(), digest);
+            sink += digest[0];
+        };
+        auto builtin_sha = [&]() { sink += crypto::Sha256::hash(data.data(), data.size())[0]; };
+        auto openssl_hmac = [&]() {
+            unsigned char mac[EVP_MAX_MD_SIZE];
+            unsigned int mac_len = 0;
+            HMAC(EVP_sha256(), secret.data(), static_cast<int>(secret.size()),
+                 reinterpret_cast<const unsigned char*>(data.data()), data.size(), mac, &mac_len);
+            sink += mac[0];
+        };
+        auto builtin_hmac = [&]() {
+            crypto::HmacSha256Stream stream(key);
+            stream.update(data.data(), data.size());
+            sink += stream.final()[0];
+        };
+
+        double openssl_sha_ns = TestUtils::MeasureNanosPerCall(openssl_sha, iterations);
+        double builtin_sha_ns = TestUtils::MeasureNanosPerCall(builtin_sha, iterations);
+        double openssl_hmac_ns = TestUtils::MeasureNanosPerCall(openssl_hmac, iterations);
+        double builtin_hmac_ns = TestUtils::MeasureNanosPerCall(builtin_hmac, iterations);
+
+        std::cout << "  " << size << " bytes:" << std::endl;
+        Report("SHA-256 OpenSSL", openssl_sha_ns);
+        Report("SHA-256 builtin", builtin_sha_ns);
+        Report("HMAC-SHA256 OpenSSL HMAC()", openssl_hmac_ns);
+        Report("HMAC-SHA256 builtin (prepared key)", builtin_hmac_ns);
+
+        EXPECT_NE(sink, 0xFFFFFFFFu);
+    }
+}
+
+TEST_F(CryptoPerformanceTest, HexCodec_VersusStringstream) {
+    const auto& cpu = simd::cpu_features();
+
+    for (size_t size : {32, 4096}) {
+        std::string random = TestUtils::RandomString(size);
+        std::vector<uint8_t> bytes(random.begin(), random.end());
+        std::string hex = simd::hex_encode(bytes.data(), bytes.size());
+        std::string out(size * 2, '\0');
+        std::vector<uint8_t> decoded(size);
+        const int iterations = size > 1024 ? 2000 : 50000;
+        unsigned sink = 0;
+
+        // Baselines: what to_hex / from_hex did before
+        auto stream_encode = [&]() {
+            std::stringstream ss;
+            ss << std::hex << std::setfill('0');
+            for (uint8_t b : bytes) {
+                ss << std::setw(2) << static_cast<unsigned int>(b);
+            }
+            sink += static_cast<unsigned char>(ss.str()[0]);
+        };
+        auto substr_decode = [&]() {
+            for (size_t i = 0; i < hex.size(); i += 2) {
+                decoded[i / 2] = static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16));
+            }
+            sink += decoded[0];
+        };
+
+        std::cout << "Hex codec, " << size << " bytes:" << std::endl;
+        double stream_ns = TestUtils::MeasureNanosPerCall(stream_encode, iterations / 10);
+        double substr_ns = TestUtils::MeasureNanosPerCall(substr_decode, iterations / 10);
+        Report("encode stringstream (before)", stream_ns);
+        Report("decode substr + stoul (before)", substr_ns);
+
+        struct Kernel {
+            const char* name;
+            bool supported;
+            void (*encode)(const uint8_t*, size_t, char*) noexcept;
+            bool (*decode)(const char*, size_t, uint8_t*) noexcept;
+        };
+        const Kernel kernels[] = {
+            {"scalar", true, simd::detail::hex_encode_scalar, simd::detail::hex_decode_scalar},
+            {"ssse3", cpu.ssse3, simd::detail::hex_encode_ssse3, simd::detail::hex_decode_ssse3},
+            {"avx2", cpu.avx2, simd::detail::hex_encode_avx2, simd::detail::hex_decode_avx2},
+        };
+        for (const auto& kernel : kernels) {
+            if (!kernel.supported) {
+                continue;
+            }
+            auto encode = [&]() {
+                kernel.encode(bytes.data(), bytes.size(), &out[0]);
+                sink += static_cast<unsigned char>(out[0]);
+            };
+            auto decode = [&]() {
+                sink += kernel.decode(hex.data(), decoded.size(), decoded.data()) ? decoded[0] : 1;
+            };
+            double encode_ns = TestUtils::MeasureNanosPerCall(encode, iterations);
+            double decode_ns = TestUtils::MeasureNanosPerCall(decode, iterations);
+            Report(std::string("encode ") + kernel.name, encode_ns);
+            Report(std::string("decode ") + kernel.name, decode_ns);
+            EXPECT_EQ(out, hex) << kernel.name;
+        }
+
+        EXPECT_NE(sink, 0xFFFFFFFFu);
+    }
+}
+
+TEST_F(CryptoPerformanceTest, DetachedEnvelope_RejectsForgeryBeforeParsing) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    auto info = TestUtils::CreateTestLicense(std::string(64, 'a'));
+    for (int i = 0; i < 64; ++i) {
+        info.features.push_back("feature_" + std::to_string(i));
+    }
+
+    // Same forged content in both formats: right shape, wrong signature
+    std::string embedded = manager.generate_license(info);
+    std::string detached = manager.generate_detached_license(info);
+    embedded[embedded.find("\"hmac_signature\": \"") + 19] ^= 0x01;
+    detached[5] ^= 0x01;
+
+    int rejected = 0;
+    auto reject_json = [&]() { rejected += !validator_->verify_json(embedded); };
+    auto reject_envelope = [&]() { rejected += !validator_->verify_envelope(detached); };
+    auto load = [&](const std::string& license) {
+        return [&manager, &license, &rejected]() {
+            try {
+                manager.load_and_validate(license);
+            } catch (const InvalidSignatureException&) {
+                ++rejected;
+            }
+        };
+    };
+
+    double json_ns = TestUtils::MeasureNanosPerCall(reject_json, BENCHMARK_ITERATIONS / 4);
+    double envelope_ns = TestUtils::MeasureNanosPerCall(reject_envelope, BENCHMARK_ITERATIONS / 4);
+    double load_json_ns = TestUtils::MeasureNanosPerCall(load(embedded), BENCHMARK_ITERATIONS / 4);
+    double load_envelope_ns = TestUtils::MeasureNanosPerCall(load(detached), BENCHMARK_ITERATIONS / 4);
+
+    std::cout << "Forged license rejection (" << detached.size() << " bytes):" << std::endl;
+    Report("verify_json (parse + canonical + MAC)", json_ns);
+    Report("verify_envelope (MAC only)", envelope_ns);
+    Report("load_and_validate, signed JSON", load_json_ns);
+    Report("load_and_validate, envelope", load_envelope_ns);
+
+    EXPECT_EQ(rejected, 4 * (BENCHMARK_ITERATIONS / 4));
+}
@@ -0,0 +1,111 @@
+#include "test_utils.hpp"
+#include "license_core/ed25519_validator.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+using namespace license_core;
+using namespace license_core::testing;
+
+class Ed25519ValidatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!Ed25519Validator::is_available()) {
+            GTEST_SKIP() << "Ed25519 needs the OpenSSL crypto backend";
+        }
+        auto pair = Ed25519Validator::generate_key_pair();
+        signer_ = std::make_unique<Ed25519Validator>(Ed25519Validator::from_private_key(pair.private_key));
+        verifier_ = std::make_unique<Ed25519Validator>(pair.public_key);
+        payload_ = TestUtils::CreateCanonicalPayload(TestUtils::CreateTestLicense());
+    }
+
+    std::unique_ptr<Ed25519Validator> signer_;
+    std::unique_ptr<Ed25519Validator> verifier_;
+    std::string payload_;
+};
+
+TEST_F(Ed25519ValidatorTest, Rfc8032_TestVector1) {
+    // RFC 8032 section 7.1, TEST 1 (empty message is rejected by our API, so
+    // only the key derivation is checked against the vector)
+    Ed25519Validator::PrivateKey seed{};
+    const std::string seed_hex = "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60";
+    const std::string public_hex = "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a";
+    for (size_t i = 0; i < seed.size(); ++i) {
+        seed[i] = static_cast<uint8_t>(std::stoul(seed_hex.substr(2 * i, 2), nullptr, 16));
+    }
+
+    auto signer = Ed25519Validator::from_private_key(seed);
+    for (size_t i = 0; i < signer.public_key().size(); ++i) {
+        EXPECT_EQ(signer.public_key()[i], std::stoul(public_hex.substr(2 * i, 2), nullptr, 16));
+    }
+}
+
+TEST(Ed25519AvailabilityTest, ThrowsWhenUnavailable) {
+    if (Ed25519Validator::is_available()) {
+        EXPECT_NO_THROW(Ed25519Validator::generate_key_pair());
+    } else {
+        EXPECT_THROW(Ed25519Validator::generate_key_pair(), CryptographicException);
+        EXPECT_THROW(Ed25519Validator(Ed25519Validator::PublicKey{}), CryptographicException);
+    }
+}
+
+TEST_F(Ed25519ValidatorTest, SignAndVerify_PublicKeyOnly) {
+    std::string signature = signer_->sign(payload_);
+    EXPECT_EQ(signature.size(), Ed25519Validator::SIGNATURE_SIZE * 2);
+
+    EXPECT_TRUE(signer_->can_sign());
+    EXPECT_FALSE(verifier_->can_sign());
+    EXPECT_TRUE(verifier_->verify(payload_, signature));
+    EXPECT_FALSE(verifier_->verify(payload_ + " ", signature));
+    EXPECT_THROW(verifier_->sign(payload_), CryptographicException);
+}
+
+TEST_F(Ed25519ValidatorTest, Verify_RejectsTamperedAndMalformed) {
+    auto signature = signer_->sign_raw(payload_);
+    EXPECT_TRUE(verifier_->verify_raw(payload_, signature));
+
+    signature[10] ^= 0x04;
+    EXPECT_FALSE(verifier_->verify_raw(payload_, signature));
+
+    EXPECT_FALSE(verifier_->verify(payload_, "not-hex"));
+    EXPECT_FALSE(verifier_->verify(payload_, std::string(128, 'g')));
+    EXPECT_THROW(verifier_->verify(payload_, ""), InvalidSignatureException);
+    EXPECT_THROW(verifier_->verify_raw("", signature), CryptographicException);
+
+    auto other = Ed25519Validator::generate_key_pair();
+    EXPECT_FALSE(Ed25519Validator(other.public_key).verify(payload_, signer_->sign(payload_)));
+}
+
+TEST_F(Ed25519ValidatorTest, VerifyBatch_MatchesSingleVerify) {
+    std::vector<std::string> payloads;
+    std::vector<std::string> signatures;
+    for (size_t len : {1, 64, 300, 2000}) {
+        payloads.push_back(TestUtils::RandomString(len));
+        signatures.push_back(signer_->sign(payloads.back()));
+    }
+    signatures[1][0] = signatures[1][0] == '0' ? '1' : '0';
+    signatures[2] = "short";
+
+    std::vector<Ed25519Validator::BatchItem> items;
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        items.push_back({payloads[i], signatures[i]});
+    }
+    items.push_back({"", signatures[0]});
+
+    auto results = verifier_->verify_batch(items);
+    ASSERT_EQ(results.size(), items.size());
+    EXPECT_EQ(results, std::vector<bool>({true, false, false, true, false}));
+    EXPECT_TRUE(verifier_->verify_batch(nullptr, 0).empty());
+}
+
+TEST_F(Ed25519ValidatorTest, Json_RoundTrip) {
+    std::string signature = signer_->sign_json(payload_);
+
+    std::string signed_json = payload_;
+    signed_json.insert(signed_json.rfind('}'), ",\n  \"ed25519_signature\": \"" + signature + "\"\n");
+    EXPECT_TRUE(verifier_->verify_json(signed_json));
+
+    std::string tampered = signed_json;
+    tampered.replace(tampered.find("test_user"), 9, "evil_user");
+    EXPECT_FALSE(verifier_->verify_json(tampered));
+    EXPECT_THROW(verifier_->verify_json(payload_), JsonParsingException);
+}
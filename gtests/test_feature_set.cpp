@@ -0,0 +1,207 @@
+#include "test_utils.hpp"
+#include "feature_set.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace license_core;
+using namespace license_core::testing;
+using namespace license_core::literals;
+
+class FeatureSetTest : public ::testing::Test {
+protected:
+    static std::vector<std::string> MakeFeatures(size_t count) {
+        std::vector<std::string> features;
+        for (size_t i = 0; i < count; ++i) {
+            features.push_back("plugin.feature_" + std::to_string(i));
+        }
+        return features;
+    }
+};
+
+TEST_F(FeatureSetTest, Contains_MatchesLinearSearch) {
+    FeatureSet set;
+    EXPECT_FALSE(set.contains("anything"));
+
+    // Rebuilt in place, larger then smaller, like a reused snapshot
+    for (size_t count : {0, 1, 2, 16, 1000, 3, 0, 256}) {
+        auto features = MakeFeatures(count);
+        features.push_back("");
+        features.push_back("dup");
+        features.push_back("dup");
+        set.build(features);
+        EXPECT_EQ(set.size(), features.size());
+
+        for (const auto& feature : features) {
+            EXPECT_TRUE(set.contains(feature)) << feature;
+            EXPECT_TRUE(set.contains(feature, feature_hash(feature)));
+        }
+        for (size_t i = count; i < count + 2000; ++i) {
+            EXPECT_FALSE(set.contains("plugin.feature_" + std::to_string(i)));
+        }
+        EXPECT_FALSE(set.contains("Dup"));
+        EXPECT_FALSE(set.contains("dup "));
+    }
+}
+
+TEST_F(FeatureSetTest, HasFeature_UsesLoadedLicense) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    auto info = TestUtils::CreateTestLicense(manager.get_current_hwid());
+    info.features = MakeFeatures(64);
+    manager.load_and_validate(manager.generate_license(info));
+
+    EXPECT_TRUE(manager.has_feature("plugin.feature_0"));
+    EXPECT_TRUE(manager.has_feature("plugin.feature_63"));
+    EXPECT_FALSE(manager.has_feature("plugin.feature_64"));
+    EXPECT_NO_THROW(manager.require_feature("plugin.feature_7"));
+    EXPECT_THROW(manager.require_feature("plugin.feature_99"), MissingFeatureException);
+
+    info.features = {"basic"};
+    manager.load_and_validate(manager.generate_license(info));
+    EXPECT_TRUE(manager.has_feature("basic"));
+    EXPECT_FALSE(manager.has_feature("plugin.feature_0"));
+}
+
+TEST_F(FeatureSetTest, FeatureName_HashedAtCompileTime) {
+    // Compile-time and run-time hashing agree for every tail length
+    constexpr FeatureName names[] = {
+        ""_feature, "a"_feature, "ab"_feature, "abc"_feature, "abcd"_feature, "abcdefg"_feature,
+        "abcdefgh"_feature, "abcdefghi"_feature, "plugin.feature_12"_feature,
+        LICENSECORE_FEATURE("premium_analytics_export"),
+    };
+    static_assert(names[9].hash() == feature_hash("premium_analytics_export"), "not a constant");
+    for (const FeatureName& name : names) {
+        const std::string copy(name.name());
+        EXPECT_EQ(name.hash(), feature_hash(copy)) << copy;
+        EXPECT_EQ(FeatureName(copy).hash(), name.hash());
+    }
+
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    EXPECT_FALSE(manager.has_feature("basic"_feature));
+    manager.set_strict_validation(true);
+    EXPECT_THROW(manager.has_feature("basic"_feature), ValidationException);
+
+    auto info = TestUtils::CreateTestLicense(manager.get_current_hwid());
+    info.features = MakeFeatures(16);
+    manager.load_and_validate(manager.generate_license(info));
+    EXPECT_TRUE(manager.has_feature("plugin.feature_12"_feature));
+    EXPECT_TRUE(manager.has_feature(LICENSECORE_FEATURE("plugin.feature_0")));
+    EXPECT_FALSE(manager.has_feature("plugin.feature_16"_feature));
+    EXPECT_FALSE(manager.has_feature("plugin.feature"_feature));
+}
+
+TEST_F(FeatureSetTest, HasFeature_VersusLinearSearch_Benchmark) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    const std::string hwid = manager.get_current_hwid();
+
+    std::cout << "has_feature, ns per check (hit = last feature, miss = absent):" << std::endl
+              << "    features   linear hit  linear miss   table hit   table miss" << std::endl;
+    for (size_t count : {1, 16, 256, 1000}) {
+        auto info = TestUtils::CreateTestLicense(hwid);
+        info.features = MakeFeatures(count);
+        manager.load_and_validate(manager.generate_license(info));
+
+        const std::string hit = info.features.back();
+        const std::string miss = "plugin.feature_missing";
+        const auto& features = info.features;
+        const int iterations = 200000;
+        size_t sink = 0;
+
+        // has_feature before the compiled table
+        auto linear = [&](const std::string& name) {
+            return TestUtils::MeasureNanosPerCall([&]() {
+                sink += std::find(features.begin(), features.end(), name) != features.end();
+            }, iterations);
+        };
+        auto table = [&](const std::string& name) {
+            return TestUtils::MeasureNanosPerCall([&]() {
+                sink += manager.has_feature(name);
+            }, iterations);
+        };
+        double linear_hit = linear(hit);
+        double linear_miss = linear(miss);
+        double table_hit = table(hit);
+        double table_miss = table(miss);
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "    " << std::setw(8) << count << std::setw(13) << linear_hit << std::setw(13) << linear_miss
+                  << std::setw(12) << table_hit << std::setw(13) << table_miss << std::endl;
+
+        EXPECT_EQ(sink, 2u * iterations);
+    }
+}
+
+TEST_F(FeatureSetTest, RegisteredFeature_FollowsReloads) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    const FeatureId early = manager.register_feature("plugin.feature_1");
+    EXPECT_FALSE(manager.has_feature(early));
+
+    auto info = TestUtils::CreateTestLicense(manager.get_current_hwid());
+    info.features = MakeFeatures(16);
+    manager.load_and_validate(manager.generate_license(info));
+    EXPECT_TRUE(manager.has_feature(early));
+
+    // Registered after the load, against the license already current
+    const FeatureId late = manager.register_feature("plugin.feature_15");
+    const FeatureId absent = manager.register_feature("plugin.feature_16");
+    EXPECT_TRUE(manager.has_feature(late));
+    EXPECT_FALSE(manager.has_feature(absent));
+    EXPECT_EQ(manager.register_feature("plugin.feature_1").index, early.index);
+
+    info.features = {"plugin.feature_16"};
+    manager.load_and_validate(manager.generate_license(info));
+    EXPECT_FALSE(manager.has_feature(early));
+    EXPECT_FALSE(manager.has_feature(late));
+    EXPECT_TRUE(manager.has_feature(absent));
+
+    // A failed load leaves the previous license current
+    EXPECT_THROW(manager.load_and_validate("{}"), LicenseException);
+    EXPECT_TRUE(manager.has_feature(absent));
+}
+
+TEST_F(FeatureSetTest, RegisteredFeature_LimitAndStrictMode) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    const size_t limit = LicenseManager::MAX_REGISTERED_FEATURES;
+    std::vector<FeatureId> ids;
+    for (size_t i = 0; i < limit; ++i) {
+        ids.push_back(manager.register_feature("plugin.feature_" + std::to_string(i)));
+        EXPECT_EQ(ids.back().index, i);
+    }
+    EXPECT_THROW(manager.register_feature("one_too_many"), ValidationException);
+    EXPECT_NO_THROW(manager.register_feature("plugin.feature_0"));
+
+    manager.set_strict_validation(true);
+    EXPECT_THROW(manager.has_feature(ids[0]), ValidationException);
+
+    auto info = TestUtils::CreateTestLicense(manager.get_current_hwid());
+    info.features = MakeFeatures(limit);
+    manager.load_and_validate(manager.generate_license(info));
+    for (const FeatureId id : ids) {
+        EXPECT_TRUE(manager.has_feature(id));
+    }
+}
+
+TEST_F(FeatureSetTest, RegisteredFeature_VersusName_Benchmark) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    auto info = TestUtils::CreateTestLicense(manager.get_current_hwid());
+    info.features = MakeFeatures(256);
+    manager.load_and_validate(manager.generate_license(info));
+
+    const std::string name = info.features.back();
+    const FeatureId id = manager.register_feature(name);
+    const int iterations = 1000000;
+    size_t sink = 0;
+
+    double by_name = TestUtils::MeasureNanosPerCall([&]() { sink += manager.has_feature(name); }, iterations);
+    double by_literal = TestUtils::MeasureNanosPerCall([&]() {
+        sink += manager.has_feature("plugin.feature_255"_feature);
+    }, iterations);
+    double by_id = TestUtils::MeasureNanosPerCall([&]() { sink += manager.has_feature(id); }, iterations);
+
+    std::cout << std::fixed << std::setprecision(2) << "has_feature, ns per check: name " << by_name
+              << ", literal " << by_literal << ", FeatureId " << by_id << std::endl;
+    EXPECT_EQ(sink, 3u * iterations);
+}
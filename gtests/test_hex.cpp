@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "simd/cpu_features.hpp"
+#include "simd/hex.hpp"
+
+using namespace license_core::simd;
+
+// Every hex kernel checked against the scalar table path
+class HexCodecTest : public ::testing::Test {
+protected:
+    using EncodeFn = void (*)(const uint8_t*, size_t, char*) noexcept;
+    using DecodeFn = bool (*)(const char*, size_t, uint8_t*) noexcept;
+
+    struct Kernel {
+        const char* name;
+        bool supported;
+        EncodeFn encode;
+        DecodeFn decode;
+    };
+
+    static std::vector<Kernel> Kernels() {
+        const auto& cpu = cpu_features();
+        return {
+            {"scalar", true, detail::hex_encode_scalar, detail::hex_decode_scalar},
+            {"ssse3", cpu.ssse3, detail::hex_encode_ssse3, detail::hex_decode_ssse3},
+            {"avx2", cpu.avx2, detail::hex_encode_avx2, detail::hex_decode_avx2},
+            {"dispatch", true, hex_encode, hex_decode},
+        };
+    }
+
+    static std::vector<uint8_t> RandomBytes(size_t length, std::mt19937& rng) {
+        std::vector<uint8_t> bytes(length);
+        for (auto& b : bytes) {
+            b = static_cast<uint8_t>(rng());
+        }
+        return bytes;
+    }
+};
+
+TEST_F(HexCodecTest, KnownVector) {
+    const uint8_t bytes[] = {0x00, 0x01, 0x7f, 0x80, 0xab, 0xcd, 0xef, 0xff};
+    EXPECT_EQ(hex_encode(bytes, sizeof(bytes)), "00017f80abcdefff");
+
+    uint8_t decoded[sizeof(bytes)] = {};
+    ASSERT_TRUE(hex_decode("00017F80aBcDeFfF", sizeof(decoded), decoded));
+    EXPECT_EQ(std::vector<uint8_t>(decoded, decoded + sizeof(decoded)),
+              std::vector<uint8_t>(bytes, bytes + sizeof(bytes)));
+}
+
+TEST_F(HexCodecTest, AllKernels_RoundTripEveryLength) {
+    std::mt19937 rng(11);
+    for (const auto& kernel : Kernels()) {
+        if (!kernel.supported) {
+            continue;
+        }
+        for (size_t len = 0; len <= 200; ++len) {
+            auto bytes = RandomBytes(len, rng);
+            std::string expected(len * 2, '\0');
+            detail::hex_encode_scalar(bytes.data(), len, &expected[0]);
+
+            std::string hex(len * 2, '\0');
+            kernel.encode(bytes.data(), len, &hex[0]);
+            ASSERT_EQ(hex, expected) << kernel.name << ", " << len << " bytes";
+
+            // Mixed case must decode to the same bytes
+            for (size_t i = 0; i < hex.size(); i += 3) {
+                hex[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(hex[i])));
+            }
+            std::vector<uint8_t> decoded(len);
+            ASSERT_TRUE(kernel.decode(hex.data(), len, decoded.data())) << kernel.name << ", " << len;
+            ASSERT_EQ(decoded, bytes) << kernel.name << ", " << len << " bytes";
+        }
+    }
+}
+
+TEST_F(HexCodecTest, AllKernels_RejectEveryNonHexCharacterAtEveryPosition) {
+    const std::string valid(2 * 80, 'a');
+    std::vector<uint8_t> out(80);
+    for (const auto& kernel : Kernels()) {
+        if (!kernel.supported) {
+            continue;
+        }
+        for (int c = 0; c < 256; ++c) {
+            const bool is_hex = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+            // Positions in the SIMD body, at block edges and in the scalar tail
+            for (size_t pos : {0, 1, 31, 32, 63, 64, 127, 128, 159}) {
+                std::string hex = valid;
+                hex[pos] = static_cast<char>(c);
+                EXPECT_EQ(kernel.decode(hex.data(), out.size(), out.data()), is_hex)
+                    << kernel.name << ", char " << c << " at " << pos;
+            }
+        }
+    }
+}
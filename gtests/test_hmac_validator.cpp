@@ -0,0 +1,332 @@
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cctype>
+
+using namespace license_core;
+using namespace license_core::testing;
+
+class HMACValidatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        validator_ = std::make_unique<HMACValidator>(DEFAULT_TEST_SECRET);
+        payload_ = TestUtils::CreateCanonicalPayload(TestUtils::CreateTestLicense());
+    }
+
+    std::unique_ptr<HMACValidator> validator_;
+    std::string payload_;
+};
+
+TEST_F(HMACValidatorTest, SignRaw_MatchesHexSignature) {
+    auto digest = validator_->sign_raw(payload_);
+    std::string hex = validator_->sign(payload_);
+
+    HMACValidator::Digest decoded{};
+    ASSERT_TRUE(HMACValidator::decode_signature(hex, decoded));
+    EXPECT_EQ(digest, decoded);
+}
+
+TEST_F(HMACValidatorTest, VerifyRaw_AcceptsOwnDigest) {
+    auto digest = validator_->sign_raw(payload_);
+    EXPECT_TRUE(validator_->verify_raw(payload_, digest));
+
+    digest[0] ^= 0x01;
+    EXPECT_FALSE(validator_->verify_raw(payload_, digest));
+}
+
+TEST_F(HMACValidatorTest, VerifyRaw_RejectsOtherKey) {
+    HMACValidator other("another-secret-key-for-unit-tests");
+    EXPECT_FALSE(other.verify_raw(payload_, validator_->sign_raw(payload_)));
+}
+
+TEST_F(HMACValidatorTest, Verify_AcceptsUppercaseHex) {
+    std::string hex = validator_->sign(payload_);
+    std::transform(hex.begin(), hex.end(), hex.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    EXPECT_TRUE(validator_->verify(payload_, hex));
+}
+
+TEST_F(HMACValidatorTest, Verify_RejectsMalformedSignature) {
+    std::string hex = validator_->sign(payload_);
+
+    EXPECT_FALSE(validator_->verify(payload_, "wrong-signature"));
+    EXPECT_FALSE(validator_->verify(payload_, hex.substr(0, 62)));
+    EXPECT_FALSE(validator_->verify(payload_, hex + "00"));
+    EXPECT_FALSE(validator_->verify(payload_, std::string(63, '0') + "g"));
+    EXPECT_THROW(validator_->verify(payload_, ""), InvalidSignatureException);
+}
+
+TEST_F(HMACValidatorTest, DecodeSignature_RejectsBadInput) {
+    HMACValidator::Digest out{};
+    EXPECT_FALSE(HMACValidator::decode_signature("", out));
+    EXPECT_FALSE(HMACValidator::decode_signature(std::string(64, 'z'), out));
+    EXPECT_TRUE(HMACValidator::decode_signature(std::string(64, 'f'), out));
+    EXPECT_EQ(out[0], 0xFF);
+}
+
+TEST_F(HMACValidatorTest, EmptyData_Throws) {
+    EXPECT_THROW(validator_->sign_raw(""), CryptographicException);
+    EXPECT_THROW(validator_->verify_raw("", HMACValidator::Digest{}), CryptographicException);
+}
+
+TEST_F(HMACValidatorTest, VerifyBatch_MatchesSingleVerify) {
+    // Lengths straddle the one- and two-tail-block padding boundaries
+    std::vector<std::string> payloads;
+    for (size_t len : {1, 55, 56, 63, 64, 65, 119, 120, 128, 400, 1000}) {
+        payloads.push_back(TestUtils::RandomString(len));
+    }
+    payloads.push_back(payload_);
+
+    std::vector<std::string> signatures;
+    for (const auto& p : payloads) {
+        signatures.push_back(validator_->sign(p));
+    }
+    // Corrupt every third signature
+    for (size_t i = 0; i < signatures.size(); i += 3) {
+        signatures[i][5] = signatures[i][5] == '0' ? '1' : '0';
+    }
+
+    std::vector<HMACValidator::BatchItem> items;
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        items.push_back({payloads[i], signatures[i]});
+    }
+
+    auto results = validator_->verify_batch(items);
+    ASSERT_EQ(results.size(), items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(results[i], validator_->verify(payloads[i], signatures[i]))
+            << "item " << i << " (length " << payloads[i].size() << ")";
+        EXPECT_EQ(results[i], i % 3 != 0);
+    }
+}
+
+TEST_F(HMACValidatorTest, VerifyBatch_HandlesInvalidItemsAndLargeBatches) {
+    std::string signature = validator_->sign(payload_);
+    std::string truncated = signature.substr(2);
+
+    // Larger than one internal chunk, with malformed items mixed in
+    std::vector<HMACValidator::BatchItem> items(1000, {payload_, signature});
+    items[3] = {"", signature};
+    items[500] = {payload_, "not-hex"};
+    items[999] = {payload_, truncated};
+
+    auto results = validator_->verify_batch(items);
+    ASSERT_EQ(results.size(), items.size());
+    EXPECT_EQ(std::count(results.begin(), results.end(), true), 997);
+    EXPECT_FALSE(results[3]);
+    EXPECT_FALSE(results[500]);
+    EXPECT_FALSE(results[999]);
+
+    EXPECT_TRUE(validator_->verify_batch(nullptr, 0).empty());
+}
+
+TEST_F(HMACValidatorTest, Stream_MatchesSignRawForAnySplit) {
+    auto expected = validator_->sign_raw(payload_);
+
+    for (size_t piece : {1, 7, 63, 64, 65, 200}) {
+        auto stream = validator_->begin_stream();
+        for (size_t pos = 0; pos < payload_.size(); pos += piece) {
+            stream.update(std::string_view(payload_).substr(pos, piece));
+        }
+        EXPECT_EQ(stream.final(), expected) << "piece size " << piece;
+    }
+}
+
+TEST_F(HMACValidatorTest, Stream_CopyForksPrefix) {
+    std::string_view view(payload_);
+    size_t half = payload_.size() / 2;
+
+    auto prefix = validator_->begin_stream();
+    prefix.update(view.substr(0, half));
+    auto fork = prefix;
+
+    EXPECT_TRUE(prefix.update(view.substr(half)).verify(validator_->sign_raw(payload_)));
+    EXPECT_EQ(fork.update("tail", 4).final(), validator_->sign_raw(std::string(view.substr(0, half)) + "tail"));
+}
+
+TEST_F(HMACValidatorTest, Stream_RejectsEmptyAndReuse) {
+    auto empty = validator_->begin_stream();
+    empty.update("");
+    EXPECT_THROW(empty.final(), CryptographicException);
+
+    auto stream = validator_->begin_stream();
+    stream.update(payload_);
+    stream.final();
+    EXPECT_THROW(stream.update("more"), CryptographicException);
+    EXPECT_THROW(stream.final(), CryptographicException);
+}
+
+TEST_F(HMACValidatorTest, Segments_MatchConcatenation) {
+    std::string_view view(payload_);
+    std::vector<std::string_view> segments = {view.substr(0, 10), "", view.substr(10, 90), view.substr(100)};
+    auto expected = validator_->sign_raw(payload_);
+
+    EXPECT_EQ(validator_->sign_segments(segments), expected);
+    EXPECT_EQ(validator_->sign_segments({view.substr(0, 3), view.substr(3)}), expected);
+    EXPECT_TRUE(validator_->verify_segments(segments, expected));
+
+    expected[31] ^= 0x80;
+    EXPECT_FALSE(validator_->verify_segments({view}, expected));
+    EXPECT_THROW(validator_->sign_segments({"", ""}), CryptographicException);
+}
+
+TEST_F(HMACValidatorTest, KeyRing_VerifiesByKeyId) {
+    HMACValidator next("next-quarter-secret-key-0001");
+    validator_->add_key("2026q4", "next-quarter-secret-key-0001");
+    EXPECT_TRUE(validator_->has_key("2026q4"));
+    EXPECT_EQ(validator_->key_count(), 2u);
+
+    std::string old_sig = validator_->sign(payload_);
+    std::string new_sig = next.sign(payload_);
+
+    EXPECT_TRUE(validator_->verify(payload_, old_sig, ""));
+    EXPECT_TRUE(validator_->verify(payload_, new_sig, "2026q4"));
+    EXPECT_FALSE(validator_->verify(payload_, new_sig, ""));
+    EXPECT_TRUE(validator_->verify_raw(payload_, next.sign_raw(payload_), "2026q4"));
+    EXPECT_TRUE(validator_->begin_stream("2026q4").update(payload_).verify(next.sign_raw(payload_)));
+    EXPECT_THROW(validator_->verify(payload_, new_sig, "unknown"), InvalidSignatureException);
+}
+
+TEST_F(HMACValidatorTest, KeyRing_SigningKeySwitch) {
+    validator_->add_key("2026q4", "next-quarter-secret-key-0001");
+    validator_->set_signing_key("2026q4");
+    EXPECT_EQ(validator_->signing_key_id(), "2026q4");
+    EXPECT_EQ(validator_->sign(payload_), HMACValidator("next-quarter-secret-key-0001").sign(payload_));
+
+    EXPECT_THROW(validator_->remove_key("2026q4"), CryptographicException);
+    EXPECT_TRUE(validator_->remove_key(""));
+    EXPECT_FALSE(validator_->remove_key(""));
+    EXPECT_THROW(validator_->set_signing_key(""), CryptographicException);
+    EXPECT_THROW(validator_->add_key("weak", "short"), CryptographicException);
+}
+
+TEST_F(HMACValidatorTest, KeyRing_LicenseManagerRotation) {
+    // Legacy licenses carry no kid and keep verifying with the constructor key
+    LicenseManager old_manager(DEFAULT_TEST_SECRET);
+    auto hwid = old_manager.get_current_hwid();
+    auto legacy = old_manager.generate_license(TestUtils::CreateTestLicense(hwid));
+
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    manager.add_key("2026q4", "next-quarter-secret-key-0001");
+    manager.set_signing_key("2026q4");
+    auto rotated = manager.generate_license(TestUtils::CreateTestLicense(hwid));
+    EXPECT_NE(rotated.find("\"kid\": \"2026q4\""), std::string::npos);
+
+    EXPECT_EQ(manager.load_and_validate(legacy).key_id, "");
+    EXPECT_EQ(manager.load_and_validate(rotated).key_id, "2026q4");
+    EXPECT_THROW(old_manager.load_and_validate(rotated), InvalidSignatureException);
+
+    // Rewriting kid invalidates the signature because kid is signed
+    std::string tampered = rotated;
+    tampered.replace(tampered.find("2026q4"), 6, "");
+    EXPECT_THROW(manager.load_and_validate(tampered), InvalidSignatureException);
+}
+
+TEST_F(HMACValidatorTest, PreparedKey_MatchesSecretKey) {
+    auto prepared = HMACValidator::prepare_key(DEFAULT_TEST_SECRET);
+    HMACValidator from_midstates = HMACValidator::from_prepared_key(prepared);
+
+    EXPECT_EQ(from_midstates.sign(payload_), validator_->sign(payload_));
+    EXPECT_TRUE(from_midstates.verify(payload_, validator_->sign(payload_)));
+
+    auto stream = from_midstates.begin_stream();
+    stream.update(payload_);
+    EXPECT_EQ(stream.final(), validator_->sign_raw(payload_));
+
+    EXPECT_THROW(HMACValidator::prepare_key("short"), CryptographicException);
+
+    // A manager built from midstates validates licenses issued with the secret
+    LicenseManager issuer(DEFAULT_TEST_SECRET);
+    LicenseManager embedded(from_midstates);
+    auto license = issuer.generate_license(TestUtils::CreateTestLicense(issuer.get_current_hwid()));
+    EXPECT_TRUE(embedded.load_and_validate(license).valid);
+}
+
+TEST_F(HMACValidatorTest, Envelope_RoundTripAndTamper) {
+    std::string envelope = validator_->seal_envelope(payload_);
+    ASSERT_TRUE(HMACValidator::is_envelope(envelope));
+    EXPECT_EQ(envelope.compare(0, 5, "LCS1 "), 0);
+    EXPECT_EQ(envelope[69], '\n');
+
+    std::string kid = "stale";
+    EXPECT_EQ(validator_->open_envelope(envelope, kid), payload_);
+    EXPECT_EQ(kid, "");
+    EXPECT_TRUE(validator_->verify_envelope(envelope));
+
+    // Any changed payload byte, signature digit or header byte is rejected
+    std::string tampered = envelope;
+    tampered[tampered.size() - 2] ^= 0x01;
+    EXPECT_THROW(validator_->open_envelope(tampered, kid), InvalidSignatureException);
+    tampered = envelope;
+    tampered[5] = tampered[5] == '0' ? '1' : '0';
+    EXPECT_THROW(validator_->open_envelope(tampered, kid), InvalidSignatureException);
+    for (std::string bad : {std::string("LCS1 "), envelope.substr(0, 70), "LCS1 zz" + envelope.substr(7),
+                            envelope.substr(0, 69) + " \n" + payload_, envelope.substr(0, 69) + "x" + envelope.substr(69)}) {
+        EXPECT_THROW(validator_->open_envelope(bad, kid), InvalidSignatureException) << bad.substr(0, 80);
+        EXPECT_FALSE(validator_->verify_envelope(bad));
+    }
+    EXPECT_FALSE(HMACValidator::is_envelope(payload_));
+    EXPECT_THROW(validator_->seal_envelope(""), CryptographicException);
+}
+
+TEST_F(HMACValidatorTest, Envelope_CarriesKeyId) {
+    validator_->add_key("2026q4", "next-quarter-secret-key-0001");
+    validator_->set_signing_key("2026q4");
+    std::string envelope = validator_->seal_envelope(payload_);
+    EXPECT_EQ(envelope.compare(69, 8, " 2026q4\n"), 0);
+
+    std::string kid;
+    EXPECT_EQ(validator_->open_envelope(envelope, kid), payload_);
+    EXPECT_EQ(kid, "2026q4");
+
+    // Non-throwing form: views into the envelope, or the reason it was rejected
+    std::string_view payload;
+    std::string_view kid_view;
+    EXPECT_EQ(validator_->try_open_envelope(envelope, payload, kid_view), nullptr);
+    EXPECT_EQ(payload, payload_);
+    EXPECT_EQ(kid_view, "2026q4");
+
+    HMACValidator old_validator(DEFAULT_TEST_SECRET);
+    EXPECT_THROW(old_validator.open_envelope(envelope, kid), InvalidSignatureException);
+    EXPECT_FALSE(old_validator.verify_envelope(envelope));
+    EXPECT_STREQ(old_validator.try_open_envelope(envelope, payload, kid_view), "Unknown envelope key id");
+    std::string tampered = envelope;
+    tampered[tampered.size() - 1] ^= 0x01;
+    EXPECT_STREQ(validator_->try_open_envelope(tampered, payload, kid_view), "Envelope HMAC verification failed");
+}
+
+TEST_F(HMACValidatorTest, Envelope_LicenseManagerDetachedLicense) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    auto info = TestUtils::CreateTestLicense(manager.get_current_hwid());
+    std::string detached = manager.generate_detached_license(info);
+    ASSERT_TRUE(HMACValidator::is_envelope(detached));
+    // The payload is plain license JSON without an embedded signature
+    EXPECT_EQ(detached.find("hmac_signature"), std::string::npos);
+
+    auto loaded = manager.load_and_validate(detached);
+    EXPECT_TRUE(loaded.valid);
+    EXPECT_EQ(loaded.user_id, info.user_id);
+    EXPECT_EQ(loaded.features, info.features);
+
+    // The signature covers exact bytes: even whitespace changes are rejected
+    std::string reformatted = detached;
+    reformatted.replace(reformatted.find("\": "), 3, "\":  ");
+    EXPECT_THROW(manager.load_and_validate(reformatted), InvalidSignatureException);
+
+    // Garbage behind a valid-looking header never reaches the parser
+    std::string garbage = detached.substr(0, 70) + "{not json";
+    EXPECT_THROW(manager.load_and_validate(garbage), InvalidSignatureException);
+
+    // The header kid must match the license's own kid
+    manager.add_key("2026q4", "next-quarter-secret-key-0001");
+    manager.set_signing_key("2026q4");
+    std::string rotated = manager.generate_detached_license(info);
+    EXPECT_EQ(manager.load_and_validate(rotated).key_id, "2026q4");
+    HMACValidator mismatched(DEFAULT_TEST_SECRET);
+    mismatched.add_key("other", "next-quarter-secret-key-0001");
+    mismatched.set_signing_key("other");
+    std::string payload(rotated.substr(rotated.find('\n') + 1));
+    std::string relabeled = mismatched.seal_envelope(payload);
+    manager.add_key("other", "next-quarter-secret-key-0001");
+    EXPECT_THROW(manager.load_and_validate(relabeled), InvalidSignatureException);
+}
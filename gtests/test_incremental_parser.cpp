@@ -0,0 +1,163 @@
+#include "test_utils.hpp"
+#include "json/incremental_parser.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace license_core;
+using namespace license_core::testing;
+
+class IncrementalParserTest : public ::testing::Test {
+protected:
+    // Feed input in chunks of chunk_size and return the finished document as a map
+    static std::unordered_map<std::string, json::JsonValue> ParseChunked(json::IncrementalParser& parser,
+                                                                         std::string_view input,
+                                                                         size_t chunk_size) {
+        parser.reset();
+        for (size_t pos = 0; pos < input.size(); pos += chunk_size) {
+            parser.feed(input.substr(pos, chunk_size));
+        }
+        json::JsonDocumentView doc;
+        parser.finish(doc);
+        return json::SimpleJson::to_map(doc);
+    }
+
+    // Offset at which feeding input one byte at a time throws, or npos
+    static size_t FailingOffset(std::string_view input) {
+        json::IncrementalParser parser;
+        for (size_t pos = 0; pos < input.size(); ++pos) {
+            try {
+                parser.feed(input.substr(pos, 1));
+            } catch (const json::JsonParsingException&) {
+                return pos;
+            }
+        }
+        return std::string_view::npos;
+    }
+};
+
+TEST_F(IncrementalParserTest, AnyChunking_MatchesParse) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    auto info = TestUtils::CreateTestLicense(std::string(64, 'a'));
+    info.features.push_back("quote\" backslash\\ unicode\\u00e9");
+    const std::string inputs[] = {
+        manager.generate_license(info),
+        "{}",
+        " \r\n{ \"a\" : [ ] , \"b\":[\"x\" ,1, \"y\"],\"n\": 42 ,\"t\":true,\"f\" :false }\n",
+        "{\"esc\": \"\\\"\\\\\\n\", \"dup\": \"1\", \"dup\": \"2\"}",
+    };
+
+    json::IncrementalParser parser;
+    for (const auto& input : inputs) {
+        const auto expected = json::SimpleJson::parse(input);
+        for (size_t chunk_size : {1, 2, 3, 7, 64, 4096}) {
+            EXPECT_EQ(ParseChunked(parser, input, chunk_size), expected) << input << " / " << chunk_size;
+            EXPECT_TRUE(parser.complete());
+            EXPECT_EQ(parser.bytes_fed(), input.size());
+            EXPECT_LE(parser.json().size(), input.size());
+        }
+    }
+}
+
+TEST_F(IncrementalParserTest, CompactForm_StillValidates) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    const std::string license = manager.generate_license(TestUtils::CreateTestLicense(manager.get_current_hwid()));
+
+    json::IncrementalParser parser;
+    ParseChunked(parser, license, 5);
+    EXPECT_LT(parser.json().size(), license.size());
+    EXPECT_EQ(parser.json().find('\n'), std::string::npos);
+    EXPECT_TRUE(manager.load_and_validate(parser.json()).valid);
+}
+
+TEST_F(IncrementalParserTest, Malformed_RejectedAtFirstBadByte) {
+    const std::pair<std::string, size_t> cases[] = {
+        {"[\"a\"]", 0},
+        {"{\"a\" \"b\"}", 5},
+        {"{\"a\": \"b\" \"c\": \"d\"}", 10},
+        {"{\"a\": \"b\",}", 10},
+        {"{\"a\": {\"b\": \"c\"}}", 6},
+        {"{\"a\": [\"b\" \"c\"]}", 11},
+        {"{\"a\": [\"b\",]}", 11},
+        {"{\"a\": tr\"ue}", 8},
+        {"{\"a\": 1]", 7},
+        {"{a: \"b\"}", 1},
+        {"{\"a\": \"b\"} {", 11},
+    };
+    for (const auto& [input, offset] : cases) {
+        EXPECT_EQ(FailingOffset(input), offset) << input;
+    }
+
+    json::IncrementalParser parser;
+    parser.feed("{\"a\": \"b\"");
+    json::JsonDocumentView doc;
+    EXPECT_THROW(parser.finish(doc), json::JsonParsingException);
+    EXPECT_FALSE(parser.complete());
+
+    // After an error the parser refuses input until reset
+    EXPECT_THROW(parser.feed("]"), json::JsonParsingException);
+    EXPECT_THROW(parser.feed("}"), json::JsonParsingException);
+    parser.reset();
+    parser.feed("{\"a\": \"b\"}");
+    EXPECT_NO_THROW(parser.finish(doc));
+    EXPECT_EQ(doc.get_string("a"), "b");
+}
+
+TEST_F(IncrementalParserTest, Limits_EnforcedWhileFeeding) {
+    const size_t chunk = 1024;
+    const size_t max_string = json::SafeJsonParser::MAX_STRING_LENGTH;
+    const size_t max_size = json::SafeJsonParser::MAX_JSON_SIZE;
+
+    // An overlong string throws before it ends and is never buffered whole
+    {
+        json::IncrementalParser parser;
+        parser.feed("{\"blob\": \"");
+        const std::string data(chunk, 'x');
+        size_t fed = 0;
+        EXPECT_THROW({
+            for (;;) {
+                parser.feed(data);
+                fed += chunk;
+            }
+        }, json::JsonParsingException);
+        EXPECT_EQ(fed, max_string);
+        EXPECT_LE(parser.json().size(), max_string + 16);
+    }
+
+    // Total size, counted over insignificant whitespace too
+    {
+        json::IncrementalParser parser;
+        parser.feed("{");
+        const std::string spaces(chunk, ' ');
+        EXPECT_THROW({
+            for (;;) parser.feed(spaces);
+        }, json::JsonSizeException);
+        EXPECT_LE(parser.bytes_fed(), max_size);
+        EXPECT_EQ(parser.json(), "{");
+    }
+
+    // Key and item counts, matching parse()
+    auto fields = [](size_t count) {
+        std::string s = "{";
+        for (size_t i = 0; i < count; ++i) {
+            s += (i ? ", \"k" : "\"k") + std::to_string(i) + "\": \"v\"";
+        }
+        return s + "}";
+    };
+    auto items = [](size_t count) {
+        std::string s = "{\"a\": [";
+        for (size_t i = 0; i < count; ++i) {
+            s += i ? ", \"x\"" : "\"x\"";
+        }
+        return s + "]}";
+    };
+    json::IncrementalParser parser;
+    const size_t max_keys = json::SafeJsonParser::MAX_OBJECT_KEYS + 1;
+    const size_t max_items = json::SafeJsonParser::MAX_ARRAY_SIZE + 1;
+    EXPECT_NO_THROW(ParseChunked(parser, fields(max_keys), 16));
+    EXPECT_THROW(ParseChunked(parser, fields(max_keys + 1), 16), json::JsonParsingException);
+    EXPECT_THROW(json::SimpleJson::parse(fields(max_keys + 1)), json::JsonParsingException);
+    EXPECT_NO_THROW(ParseChunked(parser, items(max_items), 16));
+    EXPECT_THROW(ParseChunked(parser, items(max_items + 1), 16), json::JsonParsingException);
+    EXPECT_THROW(json::SimpleJson::parse(items(max_items + 1)), json::JsonParsingException);
+}
@@ -0,0 +1,869 @@
+#include "test_utils.hpp"
+#include "json/simple_json.hpp"
+#include "license_decoder.hpp"
+#include "iso8601.hpp"
+#include "simd/cpu_features.hpp"
+#include "simd/json_index.hpp"
+#include "simd/json_escape.hpp"
+#include "license_core/license_arena.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace license_core;
+using namespace license_core::testing;
+
+// Heap allocation counter for the benchmarks below; counts every operator new
+// in this test binary.
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+class JsonParserTest : public ::testing::Test {
+protected:
+    // A real signed license as produced by LicenseManager::generate_license
+    static std::string GenerateLicense(size_t feature_count) {
+        auto info = TestUtils::CreateTestLicense(std::string(64, 'a'));
+        info.features.clear();
+        for (size_t i = 0; i < feature_count; ++i) {
+            info.features.push_back("feature_" + std::to_string(i));
+        }
+        LicenseManager manager(DEFAULT_TEST_SECRET);
+        return manager.generate_license(info);
+    }
+
+    template <typename Func>
+    static size_t CountAllocations(Func&& func) {
+        size_t before = g_allocations.load(std::memory_order_relaxed);
+        func();
+        return g_allocations.load(std::memory_order_relaxed) - before;
+    }
+};
+
+TEST_F(JsonParserTest, ParseView_MatchesParse) {
+    const std::string license = GenerateLicense(5);
+    auto map = json::SimpleJson::parse(license);
+    auto doc = json::SimpleJson::parse_view(license);
+
+    EXPECT_EQ(doc.fields().size(), map.size());
+    for (const char* key : {"user_id", "license_id", "expiry", "issued_at", "hardware_hash",
+                            "version", "hmac_signature"}) {
+        ASSERT_TRUE(doc.has_key(key)) << key;
+        EXPECT_EQ(doc.get_string(key), json::SimpleJson::get_string(map, key)) << key;
+    }
+    EXPECT_EQ(doc.get_string_array("features"), json::SimpleJson::get_string_array(map, "features"));
+    EXPECT_FALSE(doc.has_key("missing"));
+
+    // Views point into the caller's buffer
+    std::string_view user_id;
+    std::string scratch;
+    ASSERT_TRUE(doc.get_string("user_id", user_id, scratch));
+    EXPECT_GE(user_id.data(), license.data());
+    EXPECT_LT(user_id.data(), license.data() + license.size());
+}
+
+TEST_F(JsonParserTest, ParseView_UnescapesOnlyEscapedValues) {
+    const std::string json = R"({"plain": "abc", "quoted": "a\"b\\c\nd", "list": ["x", "y\"z"], "n": 42, "b": true})";
+    auto doc = json::SimpleJson::parse_view(json);
+
+    std::string scratch;
+    std::string_view value;
+    ASSERT_TRUE(doc.get_string("plain", value, scratch));
+    EXPECT_EQ(value, "abc");
+    EXPECT_TRUE(scratch.empty());
+
+    ASSERT_TRUE(doc.get_string("quoted", value, scratch));
+    EXPECT_EQ(value, "a\"b\\c\nd");
+    EXPECT_EQ(value.data(), scratch.data());
+
+    EXPECT_EQ(doc.get_string_array("list"), (std::vector<std::string>{"x", "y\"z"}));
+    EXPECT_EQ(doc.get_string("n"), "42");
+    ASSERT_NE(doc.find("b"), nullptr);
+    EXPECT_EQ(doc.find("b")->type, json::JsonFieldView::Type::Bool);
+    EXPECT_TRUE(doc.find("b")->boolean);
+    EXPECT_FALSE(doc.get_string("b", value, scratch));
+}
+
+TEST_F(JsonParserTest, Parse_DuplicateKeysAndMalformedInput) {
+    auto doc = json::SimpleJson::parse_view(R"({"k": "first", "k": "second"})");
+    EXPECT_EQ(doc.get_string("k"), "second");
+    EXPECT_EQ(json::SimpleJson::get_string(json::SimpleJson::parse(R"({"k": "first", "k": "second"})"), "k"), "second");
+
+    for (const char* bad : {"", "[]", "{\"k\": \"open}", "{\"k\" \"v\"}", "{\"k\":}", "{\"open: 1}"}) {
+        EXPECT_THROW(json::SimpleJson::parse_view(bad), json::JsonParsingException) << bad;
+        EXPECT_THROW(json::SimpleJson::parse(bad), json::JsonParsingException) << bad;
+    }
+}
+
+TEST_F(JsonParserTest, Parse_SkipsNonStringArrayItems) {
+    // Used to spin forever on the first non-string item
+    const std::string json = R"({"features": [1, "a", true, "b"], "user_id": "u"})";
+    EXPECT_EQ(json::SimpleJson::get_string_array(json::SimpleJson::parse(json), "features"),
+              (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(json::SimpleJson::parse_view(json).get_string("user_id"), "u");
+}
+
+TEST_F(JsonParserTest, ParseView_VersusParse_Benchmark) {
+    std::cout << "SimpleJson parse of signed licenses:" << std::endl;
+
+    for (size_t feature_count : {3, 32}) {
+        const std::string license = GenerateLicense(feature_count);
+        const int iterations = 20000;
+        size_t sink = 0;
+
+        json::JsonDocumentView reused;
+        json::SimpleJson::parse_view(license, reused);
+
+        auto parse_map = [&]() { sink += json::SimpleJson::parse(license).size(); };
+        auto parse_view = [&]() { sink += json::SimpleJson::parse_view(license).fields().size(); };
+        auto parse_reused = [&]() {
+            json::SimpleJson::parse_view(license, reused);
+            sink += reused.fields().size();
+        };
+
+        size_t map_allocs = CountAllocations(parse_map);
+        size_t view_allocs = CountAllocations(parse_view);
+        size_t reused_allocs = CountAllocations(parse_reused);
+
+        double map_ns = TestUtils::MeasureNanosPerCall(parse_map, iterations);
+        double view_ns = TestUtils::MeasureNanosPerCall(parse_view, iterations);
+        double reused_ns = TestUtils::MeasureNanosPerCall(parse_reused, iterations);
+
+        std::cout << "  " << license.size() << " bytes, " << feature_count << " features:" << std::endl;
+        for (auto row : {std::make_tuple("parse() -> unordered_map", map_ns, map_allocs),
+                         std::make_tuple("parse_view()", view_ns, view_allocs),
+                         std::make_tuple("parse_view(), reused document", reused_ns, reused_allocs)}) {
+            std::cout << "    " << std::left << std::setw(32) << std::get<0>(row)
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(10) << std::get<1>(row) << " ns/parse"
+                      << std::setw(6) << std::get<2>(row) << " allocations" << std::endl;
+        }
+
+        EXPECT_NE(sink, 0u);
+        EXPECT_EQ(reused_allocs, 0u);
+        EXPECT_LE(view_allocs, 3u); // field and item vectors
+        EXPECT_GT(map_allocs, 10u);
+    }
+}
+
+// Schema decoder used by LicenseManager::load_and_validate
+using decoder::LicenseField;
+
+static_assert(decoder::license_field("user_id") == LicenseField::UserId, "perfect hash");
+static_assert(decoder::license_field("kid") == LicenseField::KeyId, "perfect hash");
+static_assert(decoder::license_field("hmac_signature") == LicenseField::HmacSignature, "perfect hash");
+static_assert(decoder::license_field("user_ie") == LicenseField::Unknown, "perfect hash");
+static_assert(decoder::license_field("") == LicenseField::Unknown, "perfect hash");
+
+TEST_F(JsonParserTest, Decoder_FieldLookupIsExact) {
+    for (size_t i = 0; i < decoder::LICENSE_FIELD_COUNT; ++i) {
+        std::string name(decoder::LICENSE_FIELD_NAMES[i]);
+        EXPECT_EQ(decoder::license_field(name), static_cast<LicenseField>(i)) << name;
+        EXPECT_EQ(decoder::license_field(name + "x"), LicenseField::Unknown) << name;
+        EXPECT_EQ(decoder::license_field(name.substr(1)), LicenseField::Unknown) << name;
+    }
+    EXPECT_EQ(decoder::license_field("custom_field"), LicenseField::Unknown);
+}
+
+TEST_F(JsonParserTest, Decoder_MatchesGenericExtraction) {
+    const std::string license = GenerateLicense(4);
+    auto map = json::SimpleJson::parse(license);
+
+    decoder::DecodedLicense decoded;
+    decoder::decode_license(json::SimpleJson::parse_view(license), decoded);
+
+    EXPECT_EQ(decoded.info.user_id, json::SimpleJson::get_string(map, "user_id"));
+    EXPECT_EQ(decoded.info.license_id, json::SimpleJson::get_string(map, "license_id"));
+    EXPECT_EQ(decoded.info.hardware_hash, json::SimpleJson::get_string(map, "hardware_hash"));
+    EXPECT_EQ(decoded.info.features, json::SimpleJson::get_string_array(map, "features"));
+    EXPECT_EQ(decoded.signature, json::SimpleJson::get_string(map, "hmac_signature"));
+    EXPECT_EQ(iso8601::format(decoded.info.expiry), json::SimpleJson::get_string(map, "expiry"));
+    EXPECT_EQ(iso8601::format(decoded.info.issued_at), json::SimpleJson::get_string(map, "issued_at"));
+    EXPECT_EQ(decoded.info.version, 1u);
+    EXPECT_TRUE(decoded.info.key_id.empty());
+}
+
+TEST_F(JsonParserTest, Decoder_RejectsMalformedLicenses) {
+    const std::string base = R"("user_id": "u", "license_id": "l", "expiry": "2030-01-01T00:00:00Z", )"
+                             R"("hardware_hash": "h", "features": ["a"], "hmac_signature": "s")";
+    const std::pair<std::string, std::string> cases[] = {
+        {R"({"license_id": "l"})", "Missing required field: user_id"},
+        // Missing fields are reported before bad values, as before
+        {R"({"user_id": "", "license_id": "l", "expiry": "x", "hardware_hash": "h", "features": []})",
+         "Missing required field: hmac_signature"},
+        {"{" + base + R"(, "user_id": "again"})", "Duplicate field: user_id"},
+        {"{" + base + R"(, "kid": "a", "kid": "b"})", "Duplicate field: kid"},
+        {R"({"user_id": true, "license_id": "l", "expiry": "2030-01-01", "hardware_hash": "h", "features": [], "hmac_signature": "s"})",
+         "user_id cannot be empty"},
+        {"{" + base + R"(, "version": "v2"})", "Invalid version format"},
+        {R"({"user_id": "u", "license_id": "l", "expiry": "2030-13-01", "hardware_hash": "h", "features": [], "hmac_signature": "s"})",
+         "Invalid date format"},
+        {"{" + base + R"(, "issued_at": 5})", "Invalid date format"},
+    };
+
+    for (const auto& [json_text, message] : cases) {
+        decoder::DecodedLicense decoded;
+        try {
+            decoder::decode_license(json::SimpleJson::parse_view(json_text), decoded);
+            ADD_FAILURE() << "accepted: " << json_text;
+        } catch (const MalformedLicenseException& e) {
+            EXPECT_NE(std::string(e.what()).find(message), std::string::npos) << e.what();
+        }
+    }
+
+    // Unknown fields may repeat; the last copy is what gets signed
+    decoder::DecodedLicense decoded;
+    EXPECT_NO_THROW(decoder::decode_license(
+        json::SimpleJson::parse_view("{" + base + R"(, "note": "a", "note": "b"})"), decoded));
+    EXPECT_EQ(decoded.info.expiry, iso8601::parse("2030-01-01T00:00:00"));
+}
+
+TEST_F(JsonParserTest, Iso8601_FastPathMatchesGeneralParser) {
+    // Canonical layouts take the fast path; trailing whitespace the general one
+    for (const char* date : {"1970-01-01", "2000-02-29T12:34:56Z", "2024-02-31T00:00:00",
+                             "2038-01-19T03:14:08Z", "9999-12-31T23:59:59Z", "1969-07-20T20:17:40Z"}) {
+        auto fast = iso8601::parse(date);
+        auto general = iso8601::parse(std::string(date) + " "); // trailing space defeats the fast path
+        EXPECT_EQ(fast, general) << date;
+    }
+    EXPECT_EQ(iso8601::format(iso8601::parse("2026-10-16T13:04:54Z")), "2026-10-16T13:04:54Z");
+    EXPECT_EQ(iso8601::parse("2016-12-31T23:59:60 Z "), iso8601::parse("2017-01-01"));
+    for (const char* bad : {"", "2026-1-01", "5", "+2026-01-01", "2026-01-01T1:00:00", "2026-01-01T25:00:00",
+                            "2026-01-01Tx", "2026-01-01 junk", " 2026-01-01", "2026-01-01Z"}) {
+        EXPECT_THROW(iso8601::parse(bad), std::invalid_argument) << bad;
+    }
+}
+
+TEST_F(JsonParserTest, Decoder_VersusGenericMap_Benchmark) {
+    const std::string license = GenerateLicense(5);
+    const int iterations = 20000;
+    size_t sink = 0;
+
+    // What load_and_validate did before: map, has_key per required field, copies out
+    auto generic = [&]() {
+        auto data = json::SimpleJson::parse(license);
+        for (const char* key : {"user_id", "license_id", "expiry", "hardware_hash", "features", "hmac_signature"}) {
+            sink += json::SimpleJson::has_key(data, key);
+        }
+        LicenseInfo info;
+        info.user_id = json::SimpleJson::get_string(data, "user_id");
+        info.license_id = json::SimpleJson::get_string(data, "license_id");
+        info.hardware_hash = json::SimpleJson::get_string(data, "hardware_hash");
+        info.features = json::SimpleJson::get_string_array(data, "features");
+        info.version = std::stoul(json::SimpleJson::get_string(data, "version"));
+        info.expiry = iso8601::parse(json::SimpleJson::get_string(data, "expiry"));
+        info.issued_at = iso8601::parse(json::SimpleJson::get_string(data, "issued_at"));
+        sink += info.features.size();
+    };
+    json::JsonDocumentView doc;
+    auto decode = [&]() {
+        json::SimpleJson::parse_view(license, doc);
+        decoder::DecodedLicense decoded;
+        decoder::decode_license(doc, decoded);
+        sink += decoded.info.features.size();
+    };
+
+    size_t generic_allocs = CountAllocations(generic);
+    size_t decode_allocs = CountAllocations(decode);
+    double generic_ns = TestUtils::MeasureNanosPerCall(generic, iterations);
+    double decode_ns = TestUtils::MeasureNanosPerCall(decode, iterations);
+
+    std::cout << "License decode (" << license.size() << " bytes):" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "    generic map + get_string   " << std::setw(10) << generic_ns << " ns"
+              << std::setw(6) << generic_allocs << " allocations" << std::endl
+              << "    schema decoder             " << std::setw(10) << decode_ns << " ns"
+              << std::setw(6) << decode_allocs << " allocations" << std::endl;
+
+    EXPECT_NE(sink, 0u);
+    EXPECT_LT(decode_allocs, generic_allocs);
+}
+
+namespace {
+
+// What load_and_validate and verify_json hashed before write_canonical
+std::string MapCanonical(const json::JsonDocumentView& doc, const char* exclude_key) {
+    auto data = json::SimpleJson::to_map(doc);
+    if (exclude_key != nullptr) {
+        data.erase(exclude_key);
+    }
+    return json::SimpleJson::stringify(data);
+}
+
+std::string StreamCanonical(const json::JsonDocumentView& doc, const char* exclude_key) {
+    std::string out;
+    auto append = [&out](const char* data, size_t length) { out.append(data, length); };
+    if (exclude_key != nullptr) {
+        json::SimpleJson::write_canonical(doc, exclude_key, append);
+    } else {
+        json::SimpleJson::write_canonical(doc, append);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_F(JsonParserTest, Canonical_MatchesStringify) {
+    const std::vector<std::string> inputs = {
+        GenerateLicense(5),
+        R"({})",
+        R"({"hmac_signature": "only"})",
+        R"({"b": "2", "a": "1", "b": "3", "": "empty key"})",
+        R"({"esc": "q\"b\\s\/u\u0041n\nt\tr\rf\fb\b", "tail": "x\\"})",
+        "{\"raw\": \"tab\there\x01\x0b\", \"k\\\"ey\": true, \"off\": false}",
+        R"({"num": 42, "neg": -1.5e3, "flag": true, "arr": ["x", "y\"z", 7, "w\\n"], "empty": []})",
+        R"({"hmac_signature": "first", "a": "1", "hmac_signature": "second"})",
+    };
+    for (const auto& input : inputs) {
+        auto doc = json::SimpleJson::parse_view(input);
+        EXPECT_EQ(StreamCanonical(doc, nullptr), MapCanonical(doc, nullptr)) << input;
+        EXPECT_EQ(StreamCanonical(doc, "hmac_signature"), MapCanonical(doc, "hmac_signature")) << input;
+    }
+
+    // Long values go straight to the sink instead of through the chunk buffer
+    const std::string long_value = "{\"long\": \"" + std::string(1000, 'v') + "\\n\"}";
+    auto doc = json::SimpleJson::parse_view(long_value);
+    EXPECT_EQ(StreamCanonical(doc, nullptr), MapCanonical(doc, nullptr));
+}
+
+TEST_F(JsonParserTest, Canonical_RandomDocumentsMatchStringify) {
+    // Keys and values drawn from characters that exercise every escape rule
+    const std::string alphabet = "ab\"\\\\/nrtbfu\x01\t\n \x7f\xc3\xa9";
+    std::mt19937 rng(1234);
+    int compared = 0;
+    auto random_text = [&](size_t max_length) {
+        std::string s;
+        for (size_t n = rng() % (max_length + 1); n > 0; --n) {
+            s += alphabet[rng() % alphabet.size()];
+        }
+        // A trailing backslash would escape the closing quote
+        if (!s.empty() && s.back() == '\\') s.pop_back();
+        return "\"" + s + "\"";
+    };
+
+    for (int round = 0; round < 2000; ++round) {
+        std::string json = "{";
+        for (size_t i = rng() % 8; i > 0; --i) {
+            json += random_text(3) + ": ";
+            switch (rng() % 4) {
+                case 0: json += random_text(12); break;
+                case 1: json += (rng() % 2) ? "true" : "false"; break;
+                case 2: json += std::to_string(static_cast<int>(rng() % 2000) - 1000); break;
+                default:
+                    json += "[";
+                    for (size_t j = rng() % 4; j > 0; --j) {
+                        json += random_text(6) + (j > 1 ? ", " : "");
+                    }
+                    json += "]";
+                    break;
+            }
+            json += i > 1 ? ", " : "";
+        }
+        json += "}";
+
+        json::JsonDocumentView doc;
+        try {
+            json::SimpleJson::parse_view(json, doc);
+        } catch (const json::JsonParsingException&) {
+            continue;
+        }
+        ASSERT_EQ(StreamCanonical(doc, nullptr), MapCanonical(doc, nullptr)) << json;
+        ASSERT_EQ(StreamCanonical(doc, "a"), MapCanonical(doc, "a")) << json;
+        ++compared;
+    }
+    EXPECT_GT(compared, 500);
+}
+
+TEST_F(JsonParserTest, Canonical_VersusStringify_Benchmark) {
+    const std::string license = GenerateLicense(16);
+    const HMACValidator validator(DEFAULT_TEST_SECRET);
+    const int iterations = 20000;
+    json::JsonDocumentView doc;
+    json::SimpleJson::parse_view(license, doc);
+    size_t sink = 0;
+
+    // Map copy, erase, stringify, then hash the temporary string
+    auto materialized = [&]() {
+        auto data = json::SimpleJson::to_map(doc);
+        data.erase("hmac_signature");
+        sink += validator.sign_raw(json::SimpleJson::stringify(data))[0];
+    };
+    auto streamed = [&]() {
+        auto stream = validator.begin_stream();
+        json::SimpleJson::write_canonical(doc, "hmac_signature", [&stream](const char* data, size_t length) {
+            stream.update(data, length);
+        });
+        sink += stream.final()[0];
+    };
+
+    size_t materialized_allocs = CountAllocations(materialized);
+    size_t streamed_allocs = CountAllocations(streamed);
+    double materialized_ns = TestUtils::MeasureNanosPerCall(materialized, iterations);
+    double streamed_ns = TestUtils::MeasureNanosPerCall(streamed, iterations);
+
+    std::cout << "Canonical form HMAC (" << license.size() << " bytes):" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "    to_map + stringify + sign  " << std::setw(10) << materialized_ns << " ns"
+              << std::setw(6) << materialized_allocs << " allocations" << std::endl
+              << "    write_canonical stream     " << std::setw(10) << streamed_ns << " ns"
+              << std::setw(6) << streamed_allocs << " allocations" << std::endl;
+
+    EXPECT_NE(sink, 0u);
+    EXPECT_EQ(streamed_allocs, 0u);
+}
+
+namespace {
+
+// Pretty-printed bundle of at most `size` bytes within the parser limits:
+// feature arrays, long strings with escapes, numbers and booleans
+std::string GenerateBundle(size_t size) {
+    std::string json = "{\n";
+    const size_t budget = size - 2; // closing "\n}"
+    for (size_t field = 0; field < json::SafeJsonParser::MAX_OBJECT_KEYS; ++field) {
+        std::string entry = (field ? ",\n" : "") + std::string("  \"field_") + std::to_string(field) + "\": ";
+        switch (field % 4) {
+            case 0:
+            case 1: {
+                entry += "[";
+                for (size_t i = 0; i < json::SafeJsonParser::MAX_ARRAY_SIZE; ++i) {
+                    std::string item = (i ? ",\n    " : "\n    ") + std::string("\"module_") + std::to_string(i) +
+                                       (i % 7 ? ".feature\"" : ".quoted \\\"x\\\"\"");
+                    if (json.size() + entry.size() + item.size() + 4 > budget) {
+                        break;
+                    }
+                    entry += item;
+                }
+                entry += "\n  ]";
+                break;
+            }
+            case 2:
+                entry += "\"" + std::string(std::min<size_t>(32 * 1024, size / 8), 'x') + " tab\\t end\"";
+                break;
+            default:
+                entry += (field % 8 == 3) ? "true" : "12345";
+                break;
+        }
+        if (json.size() + entry.size() > budget) {
+            break;
+        }
+        json += entry;
+    }
+    return json + "\n}";
+}
+
+void ExpectSameDocument(const json::JsonDocumentView& a, const json::JsonDocumentView& b, const std::string& input) {
+    ASSERT_EQ(a.fields().size(), b.fields().size()) << input;
+    for (size_t i = 0; i < a.fields().size(); ++i) {
+        const auto& fa = a.fields()[i];
+        const auto& fb = b.fields()[i];
+        ASSERT_EQ(fa.key, fb.key) << input;
+        ASSERT_EQ(fa.type, fb.type) << input;
+        ASSERT_EQ(fa.value.raw, fb.value.raw) << input;
+        ASSERT_EQ(fa.value.escaped, fb.value.escaped) << input;
+        ASSERT_EQ(fa.boolean, fb.boolean) << input;
+        ASSERT_EQ(fa.item_count, fb.item_count) << input;
+        for (size_t j = 0; j < fa.item_count; ++j) {
+            ASSERT_EQ(a.items(fa)[j].raw, b.items(fb)[j].raw) << input;
+            ASSERT_EQ(a.items(fa)[j].escaped, b.items(fb)[j].escaped) << input;
+        }
+    }
+}
+
+} // namespace
+
+TEST_F(JsonParserTest, StructuralIndex_KernelsAgree) {
+    const auto& cpu = simd::cpu_features();
+    std::mt19937 rng(99);
+    const std::string alphabet = " \t\n\v\f\r\"\\,]}[{:ax0\x80\xff";
+    std::string data(4096, ' ');
+    for (char& c : data) {
+        c = alphabet[rng() % alphabet.size()];
+    }
+    const size_t blocks = data.size() / simd::JSON_BLOCK_SIZE;
+    std::vector<simd::JsonBlockMasks> scalar(blocks), sse42(blocks), avx2(blocks);
+    simd::detail::classify_json_scalar(data.data(), blocks, scalar.data());
+    if (cpu.sse42) simd::detail::classify_json_sse42(data.data(), blocks, sse42.data());
+    if (cpu.avx2) simd::detail::classify_json_avx2(data.data(), blocks, avx2.data());
+
+    for (size_t b = 0; b < blocks; ++b) {
+        for (const auto* other : {cpu.sse42 ? &sse42[b] : nullptr, cpu.avx2 ? &avx2[b] : nullptr}) {
+            if (other == nullptr) continue;
+            EXPECT_EQ(scalar[b].whitespace, other->whitespace) << b;
+            EXPECT_EQ(scalar[b].string, other->string) << b;
+            EXPECT_EQ(scalar[b].delimiter, other->delimiter) << b;
+        }
+        for (unsigned i = 0; i < simd::JSON_BLOCK_SIZE; ++i) {
+            char c = data[b * simd::JSON_BLOCK_SIZE + i];
+            EXPECT_EQ((scalar[b].whitespace >> i) & 1, (c == ' ' || (c >= '\t' && c <= '\r')) ? 1u : 0u);
+            EXPECT_EQ((scalar[b].string >> i) & 1, (c == '"' || c == '\\') ? 1u : 0u);
+            EXPECT_EQ((scalar[b].delimiter >> i) & 1, (c == ',' || c == ']' || c == '}') ? 1u : 0u);
+        }
+    }
+
+    // A partial block is padded with whitespace
+    simd::JsonBlockMasks tail;
+    simd::classify_json("\"a\",", 4, &tail);
+    EXPECT_EQ(tail.string, 0x5u);
+    EXPECT_EQ(tail.delimiter, 0x8u);
+    EXPECT_EQ(tail.whitespace, ~uint64_t(0xF));
+}
+
+TEST_F(JsonParserTest, StructuralIndex_ParseMatchesDirect) {
+    std::vector<std::string> inputs = {
+        GenerateLicense(5),
+        GenerateBundle(4 * 1024),
+        GenerateBundle(200 * 1024),
+        R"({"features": [1, "a", true, "b"], "user_id": "u"})",
+        R"({x "skipped, to": "comma", "k": "v\\"})",
+        R"({"esc": "a\"b\\c\n", "trail": "x\\", "num": -1.5 , "t": true})",
+        R"({"arr": [ "a" , "b\"]" ,, "c" ], "empty": [], "s":"v"})",
+        "{\"k\":\"v\" \v,\f\"n\":\r 7 }",
+    };
+    // Every split point of a short license exercises block boundaries
+    const std::string license = GenerateLicense(3);
+    for (size_t cut = 64; cut < license.size(); cut += 37) {
+        inputs.push_back(license.substr(0, cut) + "}");
+    }
+    // Random structural soup, mostly malformed, spanning several blocks
+    std::mt19937 rng(7);
+    const std::string alphabet = "\"\"\"\\,,:[]{} \n\tabtrue1";
+    for (int round = 0; round < 2000; ++round) {
+        std::string soup = "{";
+        for (size_t n = rng() % 300; n > 0; --n) {
+            soup += alphabet[rng() % alphabet.size()];
+        }
+        inputs.push_back(soup + "}");
+    }
+
+    json::JsonDocumentView direct;
+    json::JsonDocumentView indexed;
+    for (const auto& input : inputs) {
+        bool direct_threw = false;
+        bool indexed_threw = false;
+        try {
+            json::SimpleJson::parse_view(input, direct, json::SimpleJson::Scan::Direct);
+        } catch (const json::JsonParsingException&) {
+            direct_threw = true;
+        }
+        try {
+            json::SimpleJson::parse_view(input, indexed, json::SimpleJson::Scan::Indexed);
+        } catch (const json::JsonParsingException&) {
+            indexed_threw = true;
+        }
+        ASSERT_EQ(direct_threw, indexed_threw) << input.substr(0, 200);
+        if (!direct_threw) {
+            ExpectSameDocument(direct, indexed, input.substr(0, 200));
+        }
+    }
+}
+
+TEST_F(JsonParserTest, StructuralIndex_Throughput_Benchmark) {
+    std::cout << "SimpleJson::parse_view throughput:" << std::endl;
+
+    json::JsonDocumentView doc;
+    for (size_t size : {size_t(1024), size_t(64 * 1024), size_t(1000 * 1000)}) {
+        const std::string bundle = GenerateBundle(size);
+        const int iterations = static_cast<int>(std::max<size_t>(20, (64u << 20) / bundle.size()));
+        size_t sink = 0;
+
+        auto run = [&](json::SimpleJson::Scan scan) {
+            return TestUtils::MeasureNanosPerCall([&]() {
+                json::SimpleJson::parse_view(bundle, doc, scan);
+                sink += doc.fields().size();
+            }, iterations);
+        };
+        double direct_ns = run(json::SimpleJson::Scan::Direct);
+        double indexed_ns = run(json::SimpleJson::Scan::Indexed);
+        auto gbps = [&](double ns) { return bundle.size() / ns; };
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "    " << std::setw(8) << bundle.size() << " bytes   direct "
+                  << std::setw(6) << gbps(direct_ns) << " GB/s   indexed "
+                  << std::setw(6) << gbps(indexed_ns) << " GB/s" << std::endl;
+
+        EXPECT_NE(sink, 0u);
+    }
+}
+
+// Arena-backed parse results and validation
+
+TEST_F(JsonParserTest, Arena_ParseMatchesParse) {
+    const std::vector<std::string> inputs = {
+        GenerateLicense(5),
+        R"({"plain": "abc", "quoted": "a\"b\\c\nd", "list": ["x", "y\"z"], "n": 42, "b": true, "k": "1", "k": "2"})",
+    };
+    LicenseArena arena;
+    for (const auto& input : inputs) {
+        arena.reset();
+        auto expected = json::SimpleJson::parse(input);
+        auto actual = json::SimpleJson::parse(input, &arena);
+
+        ASSERT_EQ(actual.size(), expected.size()) << input;
+        for (const auto& [key, value] : expected) {
+            auto it = actual.find(std::pmr::string(key, &arena));
+            ASSERT_NE(it, actual.end()) << key;
+            EXPECT_EQ(it->first.get_allocator().resource(), &arena);
+            if (auto* str = std::get_if<std::string>(&value)) {
+                ASSERT_TRUE(std::holds_alternative<std::pmr::string>(it->second)) << key;
+                EXPECT_EQ(std::string_view(std::get<std::pmr::string>(it->second)), *str) << key;
+                EXPECT_EQ(std::get<std::pmr::string>(it->second).get_allocator().resource(), &arena);
+            } else if (auto* items = std::get_if<std::vector<std::string>>(&value)) {
+                const auto& actual_items = std::get<std::pmr::vector<std::pmr::string>>(it->second);
+                ASSERT_EQ(actual_items.size(), items->size()) << key;
+                for (size_t i = 0; i < items->size(); ++i) {
+                    EXPECT_EQ(std::string_view(actual_items[i]), (*items)[i]) << key;
+                    EXPECT_EQ(actual_items[i].get_allocator().resource(), &arena);
+                }
+            } else {
+                EXPECT_EQ(std::get<bool>(it->second), std::get<bool>(value)) << key;
+            }
+        }
+    }
+    EXPECT_THROW(json::SimpleJson::parse("{\"k\":}", &arena), json::JsonParsingException);
+}
+
+TEST_F(JsonParserTest, Arena_ResetReusesBlocks) {
+    LicenseArena arena(256);
+    const size_t initial = arena.capacity();
+    EXPECT_GE(initial, 256u);
+
+    auto fill = [&]() {
+        for (size_t i = 0; i < 100; ++i) {
+            void* p = arena.allocate(40 + i, i % 2 ? 8 : 64);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % (i % 2 ? 8 : 64), 0u);
+        }
+    };
+    fill();
+    const size_t grown = arena.capacity();
+    EXPECT_GT(grown, initial);
+    EXPECT_GT(arena.used(), 0u);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(CountAllocations(fill), 0u);
+    EXPECT_EQ(arena.capacity(), grown);
+}
+
+TEST_F(JsonParserTest, Arena_SteadyStateValidationDoesNotAllocate) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    auto info = TestUtils::CreateTestLicense(manager.get_current_hwid());
+    const std::string license = manager.generate_license(info);
+
+    LicenseArena arena;
+    size_t sink = 0;
+    auto validate = [&]() {
+        arena.reset();
+        pmr::LicenseInfo result = manager.load_and_validate(license, &arena);
+        sink += result.valid + result.features.size();
+    };
+
+    // The first license sizes the arena and the manager's reusable state
+    validate();
+    auto pmr_result = manager.load_and_validate(license, &arena);
+    EXPECT_TRUE(pmr_result.valid);
+    EXPECT_EQ(std::string_view(pmr_result.user_id), info.user_id);
+    ASSERT_EQ(pmr_result.features.size(), info.features.size());
+    EXPECT_EQ(pmr_result.features[0].get_allocator().resource(), &arena);
+    EXPECT_TRUE(manager.has_feature(info.features[0]));
+
+    const int iterations = 2000;
+    size_t arena_allocs = CountAllocations([&]() {
+        for (int i = 0; i < iterations; ++i) {
+            validate();
+        }
+    });
+    size_t heap_allocs = CountAllocations([&]() {
+        for (int i = 0; i < iterations; ++i) {
+            sink += manager.load_and_validate(license).features.size();
+        }
+    });
+    double arena_ns = TestUtils::MeasureNanosPerCall(validate, iterations);
+    double heap_ns = TestUtils::MeasureNanosPerCall([&]() {
+        sink += manager.load_and_validate(license).features.size();
+    }, iterations);
+
+    std::cout << "load_and_validate steady state (" << license.size() << " bytes):" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "    LicenseInfo                " << std::setw(10) << heap_ns << " ns"
+              << std::setw(8) << double(heap_allocs) / iterations << " allocations" << std::endl
+              << "    pmr::LicenseInfo + arena   " << std::setw(10) << arena_ns << " ns"
+              << std::setw(8) << double(arena_allocs) / iterations << " allocations" << std::endl;
+
+    EXPECT_NE(sink, 0u);
+    EXPECT_EQ(arena_allocs, 0u);
+    EXPECT_GT(heap_allocs, 0u);
+}
+
+// Exact-size stringify writer
+
+namespace {
+
+// stringify() as it was before the exact-size writer: ostringstream, copied
+// and sorted keys, one character at a time escaping
+std::string LegacyEscape(const std::string& str) {
+    std::string result;
+    for (char c : str) {
+        switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\b': result += "\\b"; break;
+            case '\f': result += "\\f"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default: result += c; break;
+        }
+    }
+    return result;
+}
+
+std::string LegacyStringify(const std::unordered_map<std::string, json::JsonValue>& data) {
+    std::ostringstream ss;
+    ss << "{\n";
+    std::vector<std::string> keys;
+    for (const auto& [key, _] : data) {
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    bool first = true;
+    for (const auto& key : keys) {
+        if (!first) ss << ",\n";
+        first = false;
+        ss << "  \"" << LegacyEscape(key) << "\": ";
+        std::visit([&ss](const auto& v) {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string>) {
+                ss << "\"" << LegacyEscape(v) << "\"";
+            } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+                ss << "[";
+                for (size_t i = 0; i < v.size(); ++i) {
+                    ss << (i ? ", " : "") << "\"" << LegacyEscape(v[i]) << "\"";
+                }
+                ss << "]";
+            } else if constexpr (std::is_same_v<T, bool>) {
+                ss << (v ? "true" : "false");
+            } else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, double>) {
+                ss << v;
+            } else {
+                ss << "\"unsupported_map\"";
+            }
+        }, data.at(key));
+    }
+    ss << "\n}";
+    return ss.str();
+}
+
+} // namespace
+
+TEST_F(JsonParserTest, StringifyWriter_EscapeKernelsAgree) {
+    using FindFn = size_t (*)(const char*, size_t) noexcept;
+    std::vector<std::pair<const char*, FindFn>> kernels = {{"scalar", simd::detail::find_json_escape_scalar}};
+    if (simd::cpu_features().sse2) kernels.push_back({"sse2", simd::detail::find_json_escape_sse2});
+    if (simd::cpu_features().avx2) kernels.push_back({"avx2", simd::detail::find_json_escape_avx2});
+
+    // Every byte value at every position of every length up to a few vectors
+    for (size_t length = 0; length <= 70; ++length) {
+        for (size_t position = 0; position < std::max<size_t>(length, 1); ++position) {
+            for (int byte = 0; byte < 256; ++byte) {
+                std::string data(length, 'a');
+                if (position < length) {
+                    data[position] = static_cast<char>(byte);
+                }
+                size_t expected = simd::detail::find_json_escape_scalar(data.data(), length);
+                for (const auto& [name, find] : kernels) {
+                    ASSERT_EQ(find(data.data(), length), expected) << name << " " << length << " " << position << " " << byte;
+                }
+                if (length == 0) break;
+            }
+        }
+    }
+    EXPECT_EQ(simd::find_json_escape("abc\"", 4), 3u);
+    EXPECT_EQ(simd::find_json_escape("a\vb\x01", 4), 4u); // copied through unescaped
+}
+
+TEST_F(JsonParserTest, StringifyWriter_MatchesLegacyOutput) {
+    std::mt19937 rng(20261016);
+    const std::string alphabet = std::string("abcxyz_019 \"\\/\b\f\n\r\t\v\x01\x1f\x7f") + "\xc3\xa9\xff";
+    auto random_string = [&](size_t max_length) {
+        std::string s;
+        for (size_t n = rng() % (max_length + 1); n > 0; --n) {
+            s += alphabet[rng() % alphabet.size()];
+        }
+        return s;
+    };
+
+    for (int round = 0; round < 500; ++round) {
+        std::unordered_map<std::string, json::JsonValue> data;
+        // Past 64 keys the sort order spills from the stack
+        const size_t keys = round % 10 == 0 ? 100 + rng() % 100 : rng() % 12;
+        for (size_t k = 0; k < keys; ++k) {
+            std::string key = random_string(round % 3 == 0 ? 80 : 12);
+            switch (rng() % 6) {
+                case 0: data[key] = random_string(100); break;
+                case 1: {
+                    std::vector<std::string> items;
+                    for (size_t n = rng() % 5; n > 0; --n) items.push_back(random_string(20));
+                    data[key] = items;
+                    break;
+                }
+                case 2: data[key] = static_cast<bool>(rng() % 2); break;
+                case 3: data[key] = static_cast<int>(rng()) - (1 << 30); break;
+                case 4: data[key] = std::ldexp(static_cast<double>(rng()) - 2e9, static_cast<int>(rng() % 80) - 40); break;
+                default: data[key] = std::unordered_map<std::string, std::string>{{"a", "b"}}; break;
+            }
+        }
+        ASSERT_EQ(json::SimpleJson::stringify(data), LegacyStringify(data)) << "round " << round;
+    }
+
+    auto license = json::SimpleJson::parse(GenerateLicense(8));
+    EXPECT_EQ(json::SimpleJson::stringify(license), LegacyStringify(license));
+}
+
+TEST_F(JsonParserTest, StringifyWriter_VersusLegacy_Benchmark) {
+    // The map generate_license signs, plus an escaped customer name
+    auto data = json::SimpleJson::parse(GenerateLicense(16));
+    data["customer"] = std::string("ACME \"Widgets\" Ltd.\nBilling dept.");
+    const int iterations = 20000;
+    size_t sink = 0;
+
+    auto legacy = [&]() { sink += LegacyStringify(data).size(); };
+    auto exact = [&]() { sink += json::SimpleJson::stringify(data).size(); };
+
+    size_t legacy_allocs = CountAllocations(legacy);
+    size_t exact_allocs = CountAllocations(exact);
+    double legacy_ns = TestUtils::MeasureNanosPerCall(legacy, iterations);
+    double exact_ns = TestUtils::MeasureNanosPerCall(exact, iterations);
+
+    std::cout << "SimpleJson::stringify (" << json::SimpleJson::stringify(data).size() << " bytes):" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "    ostringstream + key copies " << std::setw(10) << legacy_ns << " ns"
+              << std::setw(6) << legacy_allocs << " allocations" << std::endl
+              << "    exact-size writer          " << std::setw(10) << exact_ns << " ns"
+              << std::setw(6) << exact_allocs << " allocations" << std::endl;
+
+    EXPECT_NE(sink, 0u);
+    EXPECT_EQ(exact_allocs, 1u);
+}
@@ -0,0 +1,239 @@
+#include "test_utils.hpp"
+#include "license_binary.hpp"
+#include "license_decoder.hpp"
+#include "iso8601.hpp"
+#include "json/simple_json.hpp"
+#include "license_core/license_arena.hpp"
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace license_core;
+using namespace license_core::testing;
+
+class BinaryLicenseTest : public ::testing::Test {
+protected:
+    static LicenseInfo CreateLicense(const std::string& hwid, size_t feature_count) {
+        auto info = TestUtils::CreateTestLicense(hwid);
+        info.features.clear();
+        for (size_t i = 0; i < feature_count; ++i) {
+            info.features.push_back("feature_" + std::to_string(i));
+        }
+        return info;
+    }
+
+    static std::string Replace(std::string s, const std::string& from, const std::string& to) {
+        size_t at = s.find(from);
+        EXPECT_NE(at, std::string::npos) << from;
+        return at == std::string::npos ? s : s.replace(at, from.size(), to);
+    }
+};
+
+TEST_F(BinaryLicenseTest, RoundTrip_IsLossless) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    manager.add_key("2024-q3", "rotated-secret-key-for-binary-tests");
+    manager.set_signing_key("2024-q3");
+
+    auto info = CreateLicense(std::string(64, 'a'), 3);
+    info.features.push_back("quote\" backslash\\ newline\n tab\t");
+    info.features.push_back("");
+    info.version = 7;
+    const std::string json = manager.generate_license(info);
+
+    const std::string binary = LicenseManager::binary_license_from_json(json);
+    ASSERT_TRUE(binary::is_binary_license(binary));
+    EXPECT_LT(binary.size(), json.size());
+    EXPECT_EQ(LicenseManager::json_license_from_binary(binary), json);
+    EXPECT_EQ(LicenseManager::binary_license_from_json(LicenseManager::json_license_from_binary(binary)), binary);
+    EXPECT_EQ(manager.generate_binary_license(info), binary);
+
+    binary::LicenseView view;
+    binary::decode(binary, view);
+    EXPECT_EQ(view.user_id, info.user_id);
+    EXPECT_EQ(view.key_id, "2024-q3");
+    EXPECT_EQ(view.version, 7u);
+    ASSERT_EQ(view.feature_count(), info.features.size());
+    for (size_t i = 0; i < info.features.size(); ++i) {
+        EXPECT_EQ(view.feature(i), info.features[i]);
+    }
+
+    // The streamed canonical form is what the JSON signature covers
+    auto map = json::SimpleJson::parse(json);
+    map.erase("hmac_signature");
+    std::string canonical;
+    binary::write_canonical(view, [&](const char* data, size_t length) { canonical.append(data, length); });
+    EXPECT_EQ(canonical, json::SimpleJson::stringify(map));
+}
+
+TEST_F(BinaryLicenseTest, RoundTrip_OptionalFieldsStayAbsent) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    auto map = json::SimpleJson::parse(manager.generate_license(CreateLicense(std::string(64, 'b'), 2)));
+    map.erase("issued_at");
+    map.erase("version");
+    map.erase("hmac_signature");
+    HMACValidator validator(DEFAULT_TEST_SECRET);
+    map["hmac_signature"] = validator.sign(json::SimpleJson::stringify(map));
+    const std::string json = json::SimpleJson::stringify(map);
+
+    const std::string binary = LicenseManager::binary_license_from_json(json);
+    binary::LicenseView view;
+    binary::decode(binary, view);
+    EXPECT_EQ(view.flags, 0u);
+    EXPECT_EQ(LicenseManager::json_license_from_binary(binary), json);
+}
+
+TEST_F(BinaryLicenseTest, LoadAndValidate_AcceptsBinary) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    const auto info = CreateLicense(manager.get_current_hwid(), 4);
+    const std::string binary = manager.generate_binary_license(info);
+
+    LicenseInfo result = manager.load_and_validate(binary);
+    EXPECT_TRUE(result.valid);
+    EXPECT_EQ(result.user_id, info.user_id);
+    EXPECT_EQ(result.license_id, info.license_id);
+    EXPECT_EQ(result.features, info.features);
+    EXPECT_EQ(iso8601::format(result.expiry), iso8601::format(info.expiry));
+    EXPECT_EQ(iso8601::format(result.issued_at), iso8601::format(info.issued_at));
+    EXPECT_TRUE(manager.has_feature("feature_3"));
+
+    LicenseArena arena;
+    pmr::LicenseInfo pmr_result = manager.load_and_validate(binary, &arena);
+    EXPECT_TRUE(pmr_result.valid);
+    EXPECT_EQ(std::string_view(pmr_result.hardware_hash), info.hardware_hash);
+
+    // Signed content and the MAC are both covered
+    std::string tampered = binary;
+    tampered[tampered.find(info.user_id)] ^= 1;
+    EXPECT_THROW(manager.load_and_validate(tampered), InvalidSignatureException);
+    tampered = binary;
+    tampered[48] ^= 1;
+    EXPECT_THROW(manager.load_and_validate(tampered), InvalidSignatureException);
+
+    LicenseManager other("some-other-secret-key-for-binary-tests");
+    EXPECT_THROW(other.load_and_validate(binary), InvalidSignatureException);
+}
+
+TEST_F(BinaryLicenseTest, LoadAndValidate_RejectsUnsignedHeaderFields) {
+    // Without issued_at and version the signed form leaves both out
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    auto map = json::SimpleJson::parse(manager.generate_license(CreateLicense(manager.get_current_hwid(), 2)));
+    map.erase("issued_at");
+    map.erase("version");
+    map.erase("hmac_signature");
+    HMACValidator validator(DEFAULT_TEST_SECRET);
+    map["hmac_signature"] = validator.sign(json::SimpleJson::stringify(map));
+    const std::string binary = LicenseManager::binary_license_from_json(json::SimpleJson::stringify(map));
+    EXPECT_EQ(manager.load_and_validate(binary).version, 1u);
+
+    // Offsets of the license version and issued_at in the header
+    for (size_t offset : {8, 9, 11, 24, 28, 31}) {
+        std::string tampered = binary;
+        tampered[offset] ^= 0x02;
+        EXPECT_THROW(manager.load_and_validate(tampered), MalformedLicenseException) << offset;
+        EXPECT_THROW(LicenseManager::json_license_from_binary(tampered), MalformedLicenseException) << offset;
+    }
+}
+
+TEST_F(BinaryLicenseTest, FromJson_RejectsWhatItCannotReproduce) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    const std::string json = manager.generate_license(CreateLicense(std::string(64, 'c'), 2));
+    ASSERT_NO_THROW(LicenseManager::binary_license_from_json(json));
+
+    const std::string rejected[] = {
+        Replace(json, "\"features\"", "\"extra\": \"x\",\n  \"features\""),
+        Replace(json, "\"version\": \"1\"", "\"version\": \"01\""),
+        Replace(json, "\"version\": \"1\"", "\"version\": 1"),
+        Replace(json, "\"hmac_signature\": \"", "\"hmac_signature\": \"A"),
+        Replace(json, "T", "t"),
+    };
+    for (const auto& bad : rejected) {
+        EXPECT_THROW(LicenseManager::binary_license_from_json(bad), MalformedLicenseException) << bad;
+    }
+    EXPECT_THROW(LicenseManager::binary_license_from_json(std::string(70000, 'x')), json::JsonParsingException);
+
+    auto info = CreateLicense(std::string(64, 'c'), 1);
+    info.features[0] = std::string(json::SafeJsonParser::MAX_STRING_LENGTH, 'f'); // one over a u16 length
+    EXPECT_THROW(manager.generate_binary_license(info), MalformedLicenseException);
+}
+
+TEST_F(BinaryLicenseTest, Decode_RejectsTruncationAndCorruption) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    const std::string binary = manager.generate_binary_license(CreateLicense(std::string(64, 'd'), 5));
+    binary::LicenseView view;
+
+    for (size_t length = 0; length < binary.size(); ++length) {
+        EXPECT_THROW(binary::decode(std::string_view(binary).substr(0, length), view), MalformedLicenseException);
+    }
+    EXPECT_THROW(binary::decode(binary + '\0', view), MalformedLicenseException);
+
+    // Random corruption either decodes to a readable view or is rejected
+    std::mt19937 rng(42);
+    size_t rejected = 0;
+    for (int i = 0; i < 20000; ++i) {
+        std::string corrupt = binary;
+        for (int flips = 1 + rng() % 3; flips > 0; --flips) {
+            corrupt[rng() % corrupt.size()] = static_cast<char>(rng());
+        }
+        try {
+            binary::decode(corrupt, view);
+            size_t total = view.user_id.size() + view.license_id.size() + view.hardware_hash.size();
+            for (size_t f = 0; f < view.feature_count(); ++f) {
+                total += view.feature(f).size();
+            }
+            ASSERT_LE(total, corrupt.size());
+        } catch (const MalformedLicenseException&) {
+            ++rejected;
+        }
+    }
+    EXPECT_GT(rejected, 0u);
+}
+
+TEST_F(BinaryLicenseTest, FormatTo_MatchesFormat) {
+    using std::chrono::system_clock;
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 10000; ++i) {
+        auto seconds = static_cast<std::time_t>(rng() % 7000000000ull) - 2000000000;
+        auto time_point = system_clock::from_time_t(seconds);
+        char buffer[iso8601::FORMAT_BUFFER_SIZE];
+        size_t length = iso8601::format_to(time_point, buffer);
+        ASSERT_EQ(std::string(buffer, length), iso8601::format(time_point)) << seconds;
+    }
+}
+
+TEST_F(BinaryLicenseTest, Decode_VersusJson_Benchmark) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    const auto info = CreateLicense(std::string(64, 'e'), 8);
+    const std::string json = manager.generate_license(info);
+    const std::string binary = manager.generate_binary_license(info);
+
+    const int iterations = 20000;
+    size_t sink = 0;
+    double parse_ns = TestUtils::MeasureNanosPerCall([&]() {
+        sink += json::SimpleJson::parse(json).size();
+    }, iterations);
+
+    json::JsonDocumentView doc;
+    decoder::DecodedLicense decoded;
+    double view_ns = TestUtils::MeasureNanosPerCall([&]() {
+        json::SimpleJson::parse_view(json, doc);
+        decoder::decode_license(doc, decoded);
+        sink += decoded.info.features.size();
+    }, iterations);
+
+    binary::LicenseView view;
+    double binary_ns = TestUtils::MeasureNanosPerCall([&]() {
+        binary::decode(binary, view);
+        binary::to_info(view, decoded.info);
+        sink += decoded.info.features.size();
+    }, iterations);
+
+    std::cout << "License decode (" << json.size() << " bytes JSON, " << binary.size() << " bytes binary):" << std::endl
+              << std::fixed << std::setprecision(1)
+              << "    SimpleJson::parse              " << std::setw(10) << parse_ns << " ns" << std::endl
+              << "    parse_view + decode_license    " << std::setw(10) << view_ns << " ns" << std::endl
+              << "    binary::decode + to_info       " << std::setw(10) << binary_ns << " ns" << std::endl;
+
+    EXPECT_GT(sink, 0u);
+}
@@ -0,0 +1,188 @@
+#include "test_utils.hpp"
+#include "json/ndjson_reader.hpp"
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace license_core;
+using namespace license_core::testing;
+
+class NdjsonReaderTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        for (const auto& path : files_) {
+            std::remove(path.c_str());
+        }
+    }
+
+    std::string WriteFile(const std::string& content) {
+        auto path = (std::filesystem::temp_directory_path() /
+                     ("licensecore_ndjson_" + std::to_string(::getpid()) + "_" +
+                      std::to_string(files_.size()) + ".ndjson")).string();
+        std::ofstream(path, std::ios::binary) << content;
+        files_.push_back(path);
+        return path;
+    }
+
+    // Signed licenses, one per line, with user_id "user_<i>"
+    static std::string GenerateExport(size_t count) {
+        LicenseManager manager(DEFAULT_TEST_SECRET);
+        auto info = TestUtils::CreateTestLicense(std::string(64, 'a'));
+        std::string out;
+        for (size_t i = 0; i < count; ++i) {
+            info.user_id = "user_" + std::to_string(i);
+            for (char c : manager.generate_license(info)) {
+                if (c != '\n') {
+                    out += c;
+                }
+            }
+            out += '\n';
+        }
+        return out;
+    }
+
+    std::vector<std::string> files_;
+};
+
+TEST_F(NdjsonReaderTest, Memory_SplitsLinesAndSkipsBlanks) {
+    const std::string input = "{\"a\": \"1\"}\n\n  \r\n{\"a\": \"2\"}\r\n{\"a\": \"3\"}";
+    json::NdjsonReader reader(input);
+
+    std::vector<std::pair<size_t, std::string>> seen;
+    size_t count = reader.for_each([&](const json::NdjsonRecord& record) {
+        seen.emplace_back(record.line, record.doc.get_string("a"));
+        EXPECT_NE(record.text.back(), '\r');
+    });
+
+    EXPECT_EQ(count, 3u);
+    EXPECT_EQ(seen, (std::vector<std::pair<size_t, std::string>>{{1, "1"}, {4, "2"}, {5, "3"}}));
+
+    json::NdjsonRecord record;
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_EQ(json::NdjsonReader(std::string_view()).for_each([](const json::NdjsonRecord&) {}), 0u);
+}
+
+TEST_F(NdjsonReaderTest, BadRecord_ReportsLineAndContinues) {
+    const std::string input = "{\"a\": \"1\"}\n{\"a\": }\n{\"a\": \"3\"}\n";
+    const std::string path = WriteFile(input);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    json::NdjsonReader from_memory(input);
+    json::NdjsonReader from_fd(fd);
+    for (json::NdjsonReader* reader : {&from_memory, &from_fd}) {
+        json::NdjsonRecord record;
+        ASSERT_TRUE(reader->next(record));
+        EXPECT_EQ(record.doc.get_string("a"), "1");
+        EXPECT_THROW(reader->next(record), json::JsonParsingException);
+        EXPECT_EQ(reader->line(), 2u);
+        ASSERT_TRUE(reader->next(record));
+        EXPECT_EQ(record.line, 3u);
+        EXPECT_EQ(record.doc.get_string("a"), "3");
+        EXPECT_FALSE(reader->next(record));
+    }
+    ::close(fd);
+}
+
+TEST_F(NdjsonReaderTest, FileDescriptor_MatchesMappedFile) {
+    // Larger than the read buffer, so records straddle refills
+    const std::string input = GenerateExport(6000);
+    ASSERT_GT(input.size(), json::NdjsonReader::READ_BUFFER_SIZE);
+    const std::string path = WriteFile(input);
+
+    json::MappedFile mapped(path);
+    ASSERT_EQ(mapped.data(), input);
+    std::vector<std::string> mapped_users;
+    json::NdjsonReader(mapped.data()).for_each([&](const json::NdjsonRecord& record) {
+        mapped_users.push_back(record.doc.get_string("user_id"));
+    });
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    json::NdjsonReader reader(fd);
+    json::NdjsonRecord record;
+    size_t count = 0;
+    while (reader.next(record)) {
+        ASSERT_EQ(record.line, count + 1);
+        ASSERT_EQ(record.doc.get_string("user_id"), "user_" + std::to_string(count));
+        ASSERT_EQ(record.doc.get_string_array("features").size(), 3u);
+        ++count;
+    }
+    ::close(fd);
+
+    EXPECT_EQ(count, 6000u);
+    ASSERT_EQ(mapped_users.size(), 6000u);
+    EXPECT_EQ(mapped_users.back(), "user_5999");
+
+    EXPECT_THROW(json::MappedFile("/nonexistent/licensecore.ndjson"), std::system_error);
+}
+
+TEST_F(NdjsonReaderTest, Oversized_LineIsSkippedWithoutBuffering) {
+    const std::string big = "{\"blob\": \"" + std::string(3 * json::SafeJsonParser::MAX_JSON_SIZE, 'x') + "\"}";
+    const std::string path = WriteFile("{\"a\": \"1\"}\n" + big + "\n{\"a\": \"3\"}\n");
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    json::NdjsonReader reader(fd);
+    json::NdjsonRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_THROW(reader.next(record), json::JsonSizeException);
+    EXPECT_EQ(reader.line(), 2u);
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.line, 3u);
+    EXPECT_EQ(record.doc.get_string("a"), "3");
+    EXPECT_FALSE(reader.next(record));
+    ::close(fd);
+}
+
+TEST_F(NdjsonReaderTest, Throughput_Benchmark) {
+    const std::string input = GenerateExport(20000);
+    const std::string path = WriteFile(input);
+    const double megabytes = input.size() / 1e6;
+
+    // What audit tooling did before: getline, then a map per license
+    auto run_getline = [&]() {
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        size_t users = 0;
+        while (std::getline(in, line)) {
+            users += json::SimpleJson::has_key(json::SimpleJson::parse(line), "user_id");
+        }
+        return users;
+    };
+    auto run_fd = [&]() {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        size_t users = json::NdjsonReader(fd).for_each([](const json::NdjsonRecord& record) {
+            EXPECT_TRUE(record.doc.has_key("user_id"));
+        });
+        ::close(fd);
+        return users;
+    };
+    auto run_mapped = [&]() {
+        json::MappedFile mapped(path);
+        return json::NdjsonReader(mapped.data()).for_each([](const json::NdjsonRecord& record) {
+            EXPECT_TRUE(record.doc.has_key("user_id"));
+        });
+    };
+
+    size_t users = 0;
+    double getline_ns = TestUtils::MeasureNanosPerCall([&]() { users += run_getline(); }, 3);
+    double fd_ns = TestUtils::MeasureNanosPerCall([&]() { users += run_fd(); }, 3);
+    double mapped_ns = TestUtils::MeasureNanosPerCall([&]() { users += run_mapped(); }, 3);
+    auto mbps = [&](double ns) { return megabytes / (ns / 1e9); };
+
+    std::cout << "NDJSON export (" << std::fixed << std::setprecision(1) << megabytes << " MB, 20000 licenses):" << std::endl
+              << "    getline + SimpleJson::parse " << std::setw(8) << mbps(getline_ns) << " MB/s" << std::endl
+              << "    NdjsonReader(fd)            " << std::setw(8) << mbps(fd_ns) << " MB/s" << std::endl
+              << "    NdjsonReader(MappedFile)    " << std::setw(8) << mbps(mapped_ns) << " MB/s" << std::endl;
+
+    EXPECT_EQ(users, 9u * 20000u);
+}
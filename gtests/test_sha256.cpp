@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#ifdef LICENSECORE_TEST_WITH_OPENSSL
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#endif
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "crypto/backend.hpp"
+#include "crypto/hmac_sha256.hpp"
+#include "crypto/sha256.hpp"
+#include "embedded/embedded_license.hpp"
+#include "simd/cpu_features.hpp"
+
+using namespace license_core::crypto;
+
+// Internal SHA-256 kernels checked against OpenSSL, or against the one-shot
+// path and known answers when the tests are built without it
+class Sha256Test : public ::testing::Test {
+protected:
+    static std::string RandomBytes(size_t length, std::mt19937& rng) {
+        std::string bytes(length, '\0');
+        for (auto& c : bytes) {
+            c = static_cast<char>(rng());
+        }
+        return bytes;
+    }
+
+    static Sha256Digest Reference(const std::string& data) {
+#ifdef LICENSECORE_TEST_WITH_OPENSSL
+        Sha256Digest digest;
+        SHA256(reinterpret_cast<const unsigned char*>(data.data()), data.size(), digest.data());
+        return digest;
+#else
+        return Sha256::hash(data.data(), data.size());
+#endif
+    }
+
+    static std::string Hex(const Sha256Digest& digest) {
+        static const char digits[] = "0123456789abcdef";
+        std::string hex;
+        for (uint8_t byte : digest) {
+            hex += digits[byte >> 4];
+            hex += digits[byte & 0xF];
+        }
+        return hex;
+    }
+};
+
+TEST_F(Sha256Test, KnownAnswers) {
+    // FIPS 180-2 and RFC 4231 test case 2
+    const std::string abc = "abc";
+    EXPECT_EQ(Hex(Sha256::hash("", 0)), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(Hex(Sha256::hash(abc.data(), abc.size())),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    const std::string two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    EXPECT_EQ(Hex(Sha256::hash(two_blocks.data(), two_blocks.size())),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    const std::string data = "what do ya want for nothing?";
+    EXPECT_EQ(Hex(HmacSha256Key("Jefe").compute(data.data(), data.size())),
+              "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+}
+
+#ifdef LICENSECORE_TEST_WITH_OPENSSL
+TEST_F(Sha256Test, OneShot_MatchesOpenSSL) {
+    std::mt19937 rng(42);
+    for (size_t len = 0; len < 300; ++len) {
+        std::string data = RandomBytes(len, rng);
+        EXPECT_EQ(Sha256::hash(data.data(), data.size()), Reference(data)) << "length " << len;
+    }
+}
+
+#endif
+
+TEST_F(Sha256Test, Incremental_MatchesOneShot) {
+    std::mt19937 rng(7);
+    std::string data = RandomBytes(1000, rng);
+    for (size_t chunk : {1, 7, 63, 64, 65, 500}) {
+        Sha256 sha;
+        for (size_t i = 0; i < data.size(); i += chunk) {
+            sha.update(data.data() + i, std::min(chunk, data.size() - i));
+        }
+        EXPECT_EQ(sha.final(), Reference(data)) << "chunk " << chunk;
+    }
+}
+
+TEST_F(Sha256Test, AllKernels_Agree) {
+    const auto& cpu = license_core::simd::cpu_features();
+    std::mt19937 rng(1);
+
+    std::vector<std::string> blocks;
+    Sha256State scalar[SHA256_LANES];
+    const uint8_t* block_ptrs[SHA256_LANES];
+    for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        blocks.push_back(RandomBytes(SHA256_BLOCK_SIZE, rng));
+        scalar[lane] = SHA256_INITIAL_STATE;
+        scalar[lane][lane % 8] ^= static_cast<uint32_t>(rng());
+    }
+    for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        block_ptrs[lane] = reinterpret_cast<const uint8_t*>(blocks[lane].data());
+    }
+
+    Sha256State lanes[SHA256_LANES];
+    std::copy(std::begin(scalar), std::end(scalar), std::begin(lanes));
+
+    Sha256State dispatched[SHA256_LANES];
+    std::copy(std::begin(scalar), std::end(scalar), std::begin(dispatched));
+
+    for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        Sha256State shani = scalar[lane];
+        detail::sha256_compress_scalar(scalar[lane], block_ptrs[lane], 1);
+        if (cpu.sha) {
+            detail::sha256_compress_shani(shani, block_ptrs[lane], 1);
+            EXPECT_EQ(shani, scalar[lane]) << "SHA-NI lane " << lane;
+        }
+    }
+
+    if (cpu.sha) {
+        Sha256State first = lanes[0];
+        Sha256State second = lanes[1];
+        detail::sha256_compress_x2_shani(first, block_ptrs[0], second, block_ptrs[1]);
+        EXPECT_EQ(first, scalar[0]);
+        EXPECT_EQ(second, scalar[1]);
+    }
+
+    // Whatever engine is selected; idle (null) lanes must be left untouched
+    const uint8_t* sparse[SHA256_LANES];
+    for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        sparse[lane] = lane % 3 == 0 ? nullptr : block_ptrs[lane];
+    }
+    Sha256State before[SHA256_LANES];
+    std::copy(std::begin(dispatched), std::end(dispatched), std::begin(before));
+    sha256_compress_lanes(dispatched, sparse);
+    for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        EXPECT_EQ(dispatched[lane], lane % 3 == 0 ? before[lane] : scalar[lane]) << "lane " << lane;
+    }
+
+    if (cpu.avx2) {
+        detail::sha256_compress_x8_avx2(lanes, block_ptrs);
+        for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+            EXPECT_EQ(lanes[lane], scalar[lane]) << "AVX2 lane " << lane;
+        }
+    }
+}
+
+#ifdef LICENSECORE_TEST_WITH_OPENSSL
+TEST_F(Sha256Test, Hmac_BuiltinMatchesOpenSSL) {
+    std::mt19937 rng(99);
+    // Key lengths around the block size exercise the hashed-key path
+    for (size_t key_len : {16, 32, 63, 64, 65, 200}) {
+        std::string key = RandomBytes(key_len, rng);
+        HmacSha256Key prepared(key);
+
+        for (size_t len : {1, 55, 64, 119, 1000}) {
+            std::string data = RandomBytes(len, rng);
+
+            Sha256Digest expected;
+            unsigned int expected_len = 0;
+            HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()),
+                 reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+                 expected.data(), &expected_len);
+
+            HmacSha256Stream stream(prepared);
+            stream.update(data.data(), data.size());
+            EXPECT_EQ(stream.final(), expected) << "key " << key_len << ", data " << len;
+            EXPECT_EQ(prepared.compute(data.data(), data.size()), expected)
+                << backend_name() << " backend, key " << key_len << ", data " << len;
+        }
+    }
+}
+
+#endif
+
+TEST_F(Sha256Test, Backend_HashAndRandom) {
+    std::mt19937 rng(5);
+    std::string data = RandomBytes(777, rng);
+    EXPECT_EQ(sha256(data.data(), data.size()), Reference(data));
+
+    uint8_t a[32] = {};
+    uint8_t b[32] = {};
+    random_bytes(a, sizeof(a));
+    random_bytes(b, sizeof(b));
+    EXPECT_NE(std::memcmp(a, b, sizeof(a)), 0);
+}
+
+TEST_F(Sha256Test, EmbeddedLicense_VerifiesFromMidstates) {
+    using namespace license_core::embedded;
+    const std::string secret = "embedded-license-secret-0001";
+    const std::string payload = "{\n  \"expiry\": \"2030-01-01T00:00:00Z\"\n}";
+
+    EmbeddedKey key;
+    hmac_sha256_midstates(secret, key.inner_midstate, key.outer_midstate);
+
+    const char* features[] = {"premium"};
+    EmbeddedLicense license = {payload.data(), payload.size(),
+                               HmacSha256Key(secret).compute(payload.data(), payload.size()),
+                               1893456000, "hwid", features, 1};
+
+    EXPECT_TRUE(verify_signature_and_expiry(key, license, 1893456000));
+    EXPECT_FALSE(verify_signature_and_expiry(key, license, 1893456001));
+
+    EmbeddedLicense tampered = license;
+    tampered.signature[0] ^= 1;
+    EXPECT_FALSE(verify_signature_and_expiry(key, tampered, 0));
+
+    EmbeddedKey other;
+    hmac_sha256_midstates("another-embedded-secret-01", other.inner_midstate, other.outer_midstate);
+    EXPECT_FALSE(verify_signature_and_expiry(other, license, 0));
+}
@@ -6,6 +6,9 @@
 #include <atomic>
 #include <future>
 #include <random>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
 
 using namespace license_core;
 using namespace license_core::testing;
@@ -425,3 +428,171 @@ TEST_F(RaceConditionTest, NoRaceConditions_InCacheAccess) {
     EXPECT_EQ(total_operations, NUM_THREADS * ITERATIONS_PER_THREAD) 
         << "All operations should be accounted for";
 }
+
+// Feature checks read a published snapshot while another thread reloads
+class LicenseSnapshotTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        manager_ = std::make_unique<LicenseManager>(DEFAULT_TEST_SECRET);
+        auto basic = TestUtils::CreateTestLicense(manager_->get_current_hwid());
+        basic.features = {"common", "basic"};
+        auto premium = basic;
+        premium.features = {"common", "premium", "enterprise", "analytics"};
+        basic_features_ = basic.features;
+        premium_features_ = premium.features;
+        basic_ = manager_->generate_license(basic);
+        premium_ = manager_->generate_license(premium);
+        manager_->load_and_validate(basic_);
+    }
+    
+    // Reload alternately until stop is set; returns the number of reloads
+    size_t ReloadUntil(const std::atomic<bool>& stop, std::chrono::microseconds pause) {
+        size_t reloads = 0;
+        while (!stop.load()) {
+            manager_->load_and_validate(reloads % 2 ? basic_ : premium_);
+            ++reloads;
+            if (pause.count() > 0) {
+                std::this_thread::sleep_for(pause);
+            }
+        }
+        return reloads;
+    }
+    
+    std::unique_ptr<LicenseManager> manager_;
+    std::string basic_;
+    std::string premium_;
+    std::vector<std::string> basic_features_;
+    std::vector<std::string> premium_features_;
+};
+
+TEST_F(LicenseSnapshotTest, ConcurrentReadsDuringReload_SeeWholeLicenses) {
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::atomic<size_t> reads{0};
+    const std::string common = "common";
+    
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 8; ++t) {
+        readers.emplace_back([&]() {
+            size_t local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto features = manager_->get_available_features();
+                if (features != basic_features_ && features != premium_features_) {
+                    torn++;
+                }
+                if (!manager_->has_feature(common) || manager_->is_expired()) {
+                    torn++;
+                }
+                manager_->require_feature(common);
+                ++local;
+            }
+            reads += local;
+        });
+    }
+    
+    size_t reloads = 0;
+    while (reloads < 2000) {
+        manager_->load_and_validate(reloads % 2 ? basic_ : premium_);
+        ++reloads;
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    
+    EXPECT_EQ(torn.load(), 0) << "A reader saw a partially written license";
+    EXPECT_GT(reads.load(), 0u);
+}
+
+TEST_F(LicenseSnapshotTest, ValidateLicense_ConcurrentAndSideEffectFree) {
+    const std::string hwid = manager_->get_current_hwid();
+    std::string tampered = premium_;
+    tampered.replace(tampered.find("analytics"), 9, "analyticz");
+    
+    // Checking a license never makes it current
+    EXPECT_TRUE(manager_->validate_license(premium_, hwid));
+    EXPECT_FALSE(manager_->validate_license(premium_, "other-machine"));
+    EXPECT_FALSE(manager_->validate_license(tampered, hwid));
+    EXPECT_FALSE(manager_->validate_license("{}", hwid));
+    EXPECT_EQ(manager_->get_available_features(), basic_features_);
+    
+    // ... and any number of threads may check while another reloads
+    std::atomic<bool> stop{false};
+    std::atomic<int> wrong{0};
+    std::thread reloader([&]() { ReloadUntil(stop, std::chrono::microseconds(50)); });
+    std::vector<std::thread> validators;
+    for (int t = 0; t < 8; ++t) {
+        validators.emplace_back([&]() {
+            for (int i = 0; i < 300; ++i) {
+                if (!manager_->validate_license(i % 2 ? basic_ : premium_, hwid) ||
+                    manager_->validate_license(tampered, hwid)) {
+                    wrong++;
+                }
+            }
+        });
+    }
+    for (auto& validator : validators) {
+        validator.join();
+    }
+    stop = true;
+    reloader.join();
+    
+    EXPECT_EQ(wrong.load(), 0);
+}
+
+TEST_F(LicenseSnapshotTest, ReadScaling_Benchmark) {
+    // The same checks behind the caller-side mutex they needed before
+    std::mutex caller_mutex;
+    const std::string premium = "premium";
+    const size_t total_checks = size_t(1) << 21;
+    
+    auto run = [&](int threads, bool locked) {
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> found{0};
+        std::thread writer([&]() { ReloadUntil(stop, std::chrono::microseconds(500)); });
+        
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> readers;
+        for (int t = 0; t < threads; ++t) {
+            readers.emplace_back([&]() {
+                size_t local = 0;
+                for (size_t i = 0; i < total_checks / threads; ++i) {
+                    if (locked) {
+                        std::lock_guard<std::mutex> lock(caller_mutex);
+                        local += manager_->has_feature(premium);
+                    } else {
+                        local += manager_->has_feature(premium);
+                    }
+                }
+                found += local;
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stop = true;
+        writer.join();
+        EXPECT_LE(found.load(), total_checks);
+        return total_checks / seconds / 1e6;
+    };
+    
+    std::cout << "has_feature during reloads (" << std::thread::hardware_concurrency()
+              << " hardware threads), million checks/s:" << std::endl
+              << "    threads    snapshot   caller mutex" << std::endl;
+    double single = 0;
+    double widest = 0;
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        double snapshot = run(threads, false);
+        double locked = run(threads, true);
+        std::cout << std::fixed << std::setprecision(1)
+                  << "    " << std::setw(7) << threads << std::setw(12) << snapshot
+                  << std::setw(15) << locked << std::endl;
+        if (threads == 1) single = snapshot;
+        widest = snapshot;
+    }
+    
+    // Relaxed: readers share no counter or lock, so adding threads must not
+    // collapse aggregate throughput (it scales with cores where there are any)
+    EXPECT_GT(widest, single * 0.5);
+}
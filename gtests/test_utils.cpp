@@ -51,6 +51,17 @@ LicenseInfo TestUtils::CreateTestLicense(const std::string& hwid) {
     return info;
 }
 
+std::string TestUtils::CreateCanonicalPayload(const LicenseInfo& info) {
+    LicenseManager manager(DEFAULT_TEST_SECRET);
+    std::string license = manager.generate_license(info);
+    
+    // Canonical form is the signed document minus its "hmac_signature" line
+    auto line_start = license.find("  \"hmac_signature\"");
+    auto line_end = license.find('\n', line_start);
+    license.erase(line_start, line_end - line_start + 1);
+    return license;
+}
+
 std::string TestUtils::RandomString(size_t length) {
     static std::random_device rd;
     static std::mt19937 gen(rd());
@@ -47,6 +47,9 @@ public:
     // Create test license info
     static LicenseInfo CreateTestLicense(const std::string& hwid = "test-hardware-id");
     
+    // Canonical (signed) form of a generated license, i.e. the exact bytes fed to HMAC
+    static std::string CreateCanonicalPayload(const LicenseInfo& info);
+    
     // Generate random string
     static std::string RandomString(size_t length = 16);
     
@@ -74,6 +77,17 @@ public:
         auto avg_time = total_time / iterations;
         return avg_time.count() == 0 ? std::chrono::microseconds(1) : avg_time;
     }
+    
+    // Average cost of one call in nanoseconds, for micro-benchmarks of fast operations
+    template<typename Func>
+    static double MeasureNanosPerCall(Func&& func, int iterations) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            func();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
 };
 
 // Custom matchers for Google Test
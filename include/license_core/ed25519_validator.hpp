@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "exceptions.hpp"
+
+namespace license_core {
+
+// Asymmetric signature mode: Ed25519 (RFC 8032) through OpenSSL EVP.
+// Verifying nodes only need the public key, so licenses can be checked locally
+// without holding the signing secret. The key object is prepared once and is
+// safe to share between threads. Requires the OpenSSL crypto backend; with the
+// builtin backend every constructor throws CryptographicException.
+class Ed25519Validator {
+public:
+    static constexpr size_t PUBLIC_KEY_SIZE = 32;
+    static constexpr size_t PRIVATE_KEY_SIZE = 32; // RFC 8032 seed
+    static constexpr size_t SIGNATURE_SIZE = 64;
+    using PublicKey = std::array<uint8_t, PUBLIC_KEY_SIZE>;
+    using PrivateKey = std::array<uint8_t, PRIVATE_KEY_SIZE>;
+    using Signature = std::array<uint8_t, SIGNATURE_SIZE>;
+
+    struct KeyPair {
+        PublicKey public_key;
+        PrivateKey private_key;
+    };
+
+    // False when the library was built without an Ed25519 implementation
+    static bool is_available() noexcept;
+
+    // Verify-only validator - throws CryptographicException on an invalid key
+    explicit Ed25519Validator(const PublicKey& public_key);
+
+    // Signing validator; the public key is derived from the private key
+    static Ed25519Validator from_private_key(const PrivateKey& private_key);
+
+    // Fresh random key pair - throws CryptographicException on failure
+    static KeyPair generate_key_pair();
+
+    bool can_sign() const;
+    const PublicKey& public_key() const;
+
+    // Binary API - sign throws CryptographicException without a private key
+    Signature sign_raw(std::string_view data) const;
+    bool verify_raw(std::string_view data, const Signature& signature) const;
+
+    // Hex API mirroring HMACValidator (128 hex characters, either case on input)
+    std::string sign(const std::string& data) const;
+    bool verify(const std::string& data, const std::string& signature) const;
+    void verify_or_throw(const std::string& data, const std::string& signature) const;
+
+    // One (payload, hex signature) pair for verify_batch()
+    struct BatchItem {
+        std::string_view data;
+        std::string_view signature;
+    };
+
+    // Verify many pairs, reusing one verification context for the whole batch.
+    // Empty data or a malformed signature yields false for that item.
+    std::vector<bool> verify_batch(const BatchItem* items, size_t count) const;
+    std::vector<bool> verify_batch(const std::vector<BatchItem>& items) const;
+
+    // Decode a 128-character hex signature. Returns false on malformed input.
+    static bool decode_signature(std::string_view hex, Signature& out) noexcept;
+
+    // Utility: sign/verify normalized JSON; the signature lives in the
+    // "ed25519_signature" field - throws on parsing/crypto errors
+    std::string sign_json(const std::string& json_without_signature) const;
+    bool verify_json(const std::string& json_with_signature) const;
+
+private:
+    class Impl;
+    std::shared_ptr<const Impl> impl_;
+
+    explicit Ed25519Validator(std::shared_ptr<const Impl> impl);
+};
+
+} // namespace license_core
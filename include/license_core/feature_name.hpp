@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace license_core {
+
+namespace detail {
+
+// Little-endian load of N bytes (4 or 8). At run time on little-endian
+// targets it is a fixed-size memcpy, i.e. one load; the byte loop serves
+// constant evaluation and other targets.
+template <size_t N>
+constexpr uint64_t load_bytes(const char* p) noexcept {
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    if (!__builtin_is_constant_evaluated()) {
+        uint64_t v = 0;
+        std::memcpy(&v, p, N);
+        return v;
+    }
+#endif
+    uint64_t v = 0;
+    for (size_t i = 0; i < N; ++i) {
+        v |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return v;
+}
+
+constexpr uint64_t mix(uint64_t h) noexcept {
+    h *= 0x9e3779b97f4a7c15ull;
+    return h ^ (h >> 29);
+}
+
+} // namespace detail
+
+// Eight bytes per multiply and a branch-light tail of overlapping loads;
+// usable in constant expressions. Both the low (table) and high (bitset)
+// bits are well mixed.
+constexpr uint64_t feature_hash(std::string_view name) noexcept {
+    const char* p = name.data();
+    const size_t n = name.size();
+    uint64_t hash = 0xcbf29ce484222325ull ^ n;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        hash = detail::mix(hash ^ detail::load_bytes<8>(p + i));
+    }
+    const size_t rest = n - i;
+    if (rest >= 4) {
+        hash = detail::mix(hash ^ (detail::load_bytes<4>(p + i) << 32) ^ detail::load_bytes<4>(p + n - 4));
+    } else if (rest > 0) {
+        const auto byte = [](char c) { return static_cast<uint64_t>(static_cast<unsigned char>(c)); };
+        hash = detail::mix(hash ^ (byte(p[i]) << 16) ^ (byte(p[i + rest / 2]) << 8) ^ byte(p[n - 1]));
+    }
+    hash *= 0xff51afd7ed558ccdull;
+    return hash ^ (hash >> 32);
+}
+
+// A feature name with its feature_hash, for LicenseManager::has_feature. Made
+// from a literal with "name"_feature or LICENSECORE_FEATURE("name") the hash
+// is a compile-time constant, so a check only probes the license's feature
+// table and compares the name on a hash match.
+class FeatureName {
+public:
+    // Hashes name here: at run time unless in a constant expression
+    explicit constexpr FeatureName(std::string_view name) noexcept
+        : name_(name), hash_(feature_hash(name)) {}
+
+    // hash must be feature_hash(name)
+    constexpr FeatureName(std::string_view name, uint64_t hash) noexcept
+        : name_(name), hash_(hash) {}
+
+    constexpr std::string_view name() const noexcept { return name_; }
+    constexpr uint64_t hash() const noexcept { return hash_; }
+
+private:
+    std::string_view name_;
+    uint64_t hash_;
+};
+
+namespace literals {
+
+// "analytics"_feature; always hashed at compile time under C++20, and in
+// C++17 when used to initialize a constexpr variable
+#if __cplusplus >= 202002L && defined(__cpp_consteval)
+consteval
+#else
+constexpr
+#endif
+FeatureName operator""_feature(const char* name, size_t size) noexcept {
+    return FeatureName(std::string_view(name, size));
+}
+
+} // namespace literals
+
+#if __cplusplus >= 202002L && defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+#define LICENSECORE_HAS_FEATURE_TEMPLATE 1
+
+// A string literal as a template argument, for has_feature<"analytics">()
+template <size_t N>
+struct FixedString {
+    char chars[N] = {};
+
+    consteval FixedString(const char (&name)[N]) noexcept {
+        for (size_t i = 0; i < N; ++i) {
+            chars[i] = name[i];
+        }
+    }
+    constexpr std::string_view view() const noexcept { return std::string_view(chars, N - 1); }
+};
+#endif
+
+} // namespace license_core
+
+// C++17 form of "name"_feature: the hash is a template argument, so it is a
+// compile-time constant wherever the macro is used. name must be a literal.
+#define LICENSECORE_FEATURE(name) \
+    ::license_core::FeatureName(name, std::integral_constant<uint64_t, ::license_core::feature_hash(name)>::value)
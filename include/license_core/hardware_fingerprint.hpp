@@ -28,6 +28,10 @@ public:
     // Get hardware fingerprint as hash string - throws HardwareDetectionException on failure
     std::string get_fingerprint() const;
     
+    // Same, written into out; reuses its capacity, so repeated calls on a
+    // cached fingerprint do not allocate
+    void get_fingerprint(std::string& out) const;
+    
     // Get individual components (for debugging) - may throw HardwareDetectionException
     std::string get_cpu_id() const;
     std::string get_mac_address() const;
@@ -1,20 +1,56 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
+#include <memory>
 #include "exceptions.hpp"
 
 // Forward declaration
 namespace license_core {
     struct LicenseInfo;
+    namespace crypto {
+        class HmacSha256Key;
+    }
 }
 
 namespace license_core {
 
 class HMACValidator {
 public:
+    static constexpr size_t DIGEST_SIZE = 32;
+    using Digest = std::array<uint8_t, DIGEST_SIZE>;
+    
     explicit HMACValidator(const std::string& secret_key);
     
+    // HMAC key reduced to its inner/outer SHA-256 midstates. A validator built
+    // from it never sees the raw secret and skips the key schedule entirely;
+    // the LICENSECORE_EMBEDDED_KEY_FILE build step embeds one in the binary.
+    struct PreparedKey {
+        std::array<uint32_t, 8> inner;
+        std::array<uint32_t, 8> outer;
+    };
+    
+    // Throws CryptographicException on an empty or too short secret
+    static PreparedKey prepare_key(const std::string& secret_key);
+    static HMACValidator from_prepared_key(const PreparedKey& key);
+    
+    // Key ring for secret rotation. Additional keys are addressed by a key id
+    // ("kid"); the constructor key has the empty id. Each key's HMAC state is
+    // prepared once when added and looked up in O(1). Signing uses the signing
+    // key (initially the constructor key).
+    void add_key(const std::string& kid, const std::string& secret_key); // replaces an existing kid
+    bool remove_key(const std::string& kid); // throws CryptographicException for the signing key
+    bool has_key(const std::string& kid) const;
+    size_t key_count() const;
+    void set_signing_key(const std::string& kid); // throws CryptographicException if unknown
+    const std::string& signing_key_id() const;
+    
     // Generate HMAC signature for data - throws CryptographicException on failure
     std::string sign(const std::string& data) const;
     
@@ -22,19 +58,120 @@ public:
     bool verify(const std::string& data, const std::string& signature) const;
     void verify_or_throw(const std::string& data, const std::string& signature) const;
     
+    // Verify with the key registered under kid - throws InvalidSignatureException for an unknown kid
+    bool verify(const std::string& data, const std::string& signature, const std::string& kid) const;
+    
+    // Binary digest API: no hex round-trip and no heap allocation on any
+    // backend, as the MAC resumes from the key's prepared midstates.
+    // sign()/verify() above are thin hex wrappers around these.
+    Digest sign_raw(std::string_view data) const;
+    bool verify_raw(std::string_view data, const Digest& signature) const;
+    bool verify_raw(std::string_view data, const Digest& signature, const std::string& kid) const;
+    
+    // Incremental signer for payloads produced piece by piece. The digest equals
+    // sign_raw() of everything passed to update(), so callers never need to
+    // assemble the payload. State lives inline (no heap); copying a stream forks
+    // it, e.g. to reuse a common prefix.
+    class Stream {
+    public:
+        Stream& update(std::string_view data);
+        Stream& update(const void* data, size_t length);
+        
+        // Finish and return the digest - throws CryptographicException when no
+        // bytes were fed or the stream was already finished
+        Digest final();
+        
+        // Finish and compare against signature in constant time
+        bool verify(const Digest& signature);
+        
+    private:
+        friend class HMACValidator;
+        Stream() = default;
+        
+        static constexpr size_t STATE_SIZE = 160;
+        alignas(8) unsigned char state_[STATE_SIZE];
+        uint64_t length_ = 0;
+        bool finished_ = false;
+    };
+    
+    // Start an incremental computation with this validator's key
+    Stream begin_stream() const;
+    Stream begin_stream(const std::string& kid) const;
+    
+    // Sign/verify the concatenation of several segments without joining them
+    Digest sign_segments(std::initializer_list<std::string_view> segments) const;
+    Digest sign_segments(const std::vector<std::string_view>& segments) const;
+    bool verify_segments(std::initializer_list<std::string_view> segments, const Digest& signature) const;
+    bool verify_segments(const std::vector<std::string_view>& segments, const Digest& signature) const;
+    
+    // One (payload, hex signature) pair for verify_batch()
+    struct BatchItem {
+        std::string_view data;
+        std::string_view signature;
+    };
+    
+    // Verify many independent pairs at once; result[i] is true when item i
+    // verifies. Several messages are hashed in parallel SIMD lanes when the CPU
+    // supports it. Empty data or a malformed signature yields false for that
+    // item instead of throwing.
+    std::vector<bool> verify_batch(const BatchItem* items, size_t count) const;
+    std::vector<bool> verify_batch(const std::vector<BatchItem>& items) const;
+    
+    // Crypto backend compiled into the library: "openssl" or "builtin"
+    static const char* crypto_backend() noexcept;
+    
+    // Decode a 64-character hex signature (either case) into a digest.
+    // Returns false instead of throwing on malformed input.
+    static bool decode_signature(std::string_view hex, Digest& out) noexcept;
+    
     // Utility: sign JSON without signature field - throws on parsing/crypto errors
     std::string sign_json(const std::string& json_without_signature) const;
     
-    // Utility: verify JSON by extracting signature field - throws on errors
+    // Utility: verify JSON by extracting signature field - throws on errors.
+    // An optional "kid" field selects the key from the key ring.
     bool verify_json(const std::string& json_with_signature) const;
     void verify_json_or_throw(const std::string& json_with_signature) const;
     
+    // Detached-signature envelope. The MAC covers the exact payload bytes and
+    // sits in a fixed-position header, so a forged or corrupted input is
+    // rejected at hashing speed before anything parses it:
+    //   "LCS1 " <64 hex HMAC-SHA256 of payload> [" " kid] "\n" <payload>
+    static constexpr std::string_view ENVELOPE_MAGIC = "LCS1 ";
+    static bool is_envelope(std::string_view data) noexcept;
+    
+    // Wrap payload, signed with the signing key; a non-empty signing key id
+    // goes in the header. Throws CryptographicException on an empty payload.
+    std::string seal_envelope(std::string_view payload) const;
+    
+    // Verify the MAC and return the payload (a view into envelope) and the
+    // header key id. Throws InvalidSignatureException on a malformed header,
+    // unknown kid or MAC mismatch.
+    std::string_view open_envelope(std::string_view envelope, std::string& kid) const;
+    
+    // open_envelope without exceptions: on success sets payload and kid (views
+    // into envelope) and returns nullptr, otherwise returns the reason
+    const char* try_open_envelope(std::string_view envelope, std::string_view& payload,
+                                  std::string_view& kid) const noexcept;
+    
+    // Non-throwing gate for untrusted input: header check plus one HMAC
+    bool verify_envelope(std::string_view envelope) const noexcept;
+    
     // License validation - throws LicenseValidationException on failure
     bool validate_license(const LicenseInfo& license_info, const std::string& hardware_id) const;
     
 private:
-    std::string secret_key_;
+    using KeyPtr = std::shared_ptr<const crypto::HmacSha256Key>;
+    
+    // Keyed HMAC state prepared once per key; shared by copies.
+    // key_ is the signing key, keys_ holds every key by id (including it).
+    KeyPtr key_;
+    std::unordered_map<std::string, KeyPtr> keys_;
+    std::string signing_kid_;
+    
+    explicit HMACValidator(KeyPtr key);
     
+    const crypto::HmacSha256Key& key_for(const std::string& kid) const;
+    static Stream start_stream(const crypto::HmacSha256Key& key);
     std::string compute_hmac_sha256(const std::string& data) const;
     std::string to_hex(const std::vector<uint8_t>& bytes) const;
     std::vector<uint8_t> from_hex(const std::string& hex) const;
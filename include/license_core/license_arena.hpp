@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace license_core {
+
+// Reusable monotonic arena for per-license allocations: parse results and
+// pmr::LicenseInfo strings. Allocation bumps a pointer and deallocation is a
+// no-op. reset() rewinds without giving memory back, so once the arena has
+// grown to fit a license, later licenses are served without touching the heap.
+// Not thread-safe; use one arena per thread.
+class LicenseArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 8 * 1024;
+
+    explicit LicenseArena(size_t initial_size = DEFAULT_BLOCK_SIZE,
+                          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~LicenseArena() override;
+
+    LicenseArena(const LicenseArena&) = delete;
+    LicenseArena& operator=(const LicenseArena&) = delete;
+
+    // Rewind to empty; everything allocated from the arena must be dead by now
+    void reset() noexcept;
+
+    size_t capacity() const noexcept; // bytes held in blocks
+    size_t used() const noexcept;     // bytes handed out since the last reset, with padding
+
+private:
+    struct Block;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    Block* add_block(size_t min_size);
+
+    std::pmr::memory_resource* upstream_;
+    size_t next_block_size_;
+    Block* first_ = nullptr;   // blocks in allocation order, kept across reset()
+    Block* current_ = nullptr; // block being filled
+    size_t offset_ = 0;        // fill level of current_
+    size_t used_ = 0;
+};
+
+} // namespace license_core
@@ -4,7 +4,10 @@
 #include <vector>
 #include <chrono>
 #include <memory>
+#include <memory_resource>
+#include "feature_name.hpp"
 #include "hardware_fingerprint.hpp"
+#include "hmac_validator.hpp"
 #include "exceptions.hpp"
 
 namespace license_core {
@@ -17,25 +20,129 @@ struct LicenseInfo {
     std::chrono::system_clock::time_point issued_at;
     std::string license_id;
     uint32_t version = 1;
+    std::string key_id; // signing key id ("kid"); empty for the default key
     bool valid = false;
     std::string error_message;
 };
 
+namespace pmr {
+
+// LicenseInfo with its strings allocated from a memory resource, such as a
+// LicenseArena that is reset between licenses
+struct LicenseInfo {
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    
+    explicit LicenseInfo(allocator_type alloc = {})
+        : user_id(alloc), hardware_hash(alloc), features(alloc),
+          license_id(alloc), key_id(alloc), error_message(alloc) {}
+    
+    std::pmr::string user_id;
+    std::pmr::string hardware_hash;
+    std::pmr::vector<std::pmr::string> features;
+    std::chrono::system_clock::time_point expiry;
+    std::chrono::system_clock::time_point issued_at;
+    std::pmr::string license_id;
+    uint32_t version = 1;
+    std::pmr::string key_id;
+    bool valid = false;
+    std::pmr::string error_message;
+};
+
+} // namespace pmr
+
+// Opt-in cache of validation results for licenses that are loaded repeatedly.
+// Entries are keyed by the raw license bytes and live until the license expires.
+struct ValidationCacheConfig {
+    bool enabled = false;
+    size_t capacity = 1024; // total entries across all shards
+    size_t shards = 16;     // independently locked LRU partitions
+};
+
+struct ValidationCacheStats {
+    size_t cache_hits = 0;
+    size_t cache_misses = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+    double hit_rate() const {
+        return cache_hits + cache_misses > 0 ?
+            static_cast<double>(cache_hits) / (cache_hits + cache_misses) : 0.0;
+    }
+};
+
+// Handle returned by LicenseManager::register_feature; only meaningful to the
+// manager that issued it
+struct FeatureId {
+    uint8_t index = 0;
+};
+
 class LicenseManager {
 public:
     explicit LicenseManager(const std::string& secret_key);
+    explicit LicenseManager(const HMACValidator& validator); // e.g. from an embedded prepared key
     ~LicenseManager();
 
-    // Core functionality - now throws exceptions instead of returning error info
+    // Core functionality - now throws exceptions instead of returning error info.
+    // Accepts signed JSON, detached-signature envelopes and binary licenses
+    // (see below).
     LicenseInfo load_and_validate(const std::string& license_json);
+    
+    // Same checks, with the result and all parse scratch allocated from
+    // resource (typically a LicenseArena reset between licenses). With the
+    // validation cache off, a warmed-up loop over this overload makes no
+    // global heap allocations.
+    pmr::LicenseInfo load_and_validate(const std::string& license_json, std::pmr::memory_resource* resource);
+    
+    // True if license_json passes every load_and_validate check and is bound
+    // to hardware_id (which must also be this machine). Changes nothing: the
+    // loaded license stays current, so concurrent calls need no locking -
+    // provided the HardwareConfig keeps thread_safe_cache on (the default),
+    // since each call probes the fingerprint.
     bool validate_license(const std::string& license_json, const std::string& hardware_id) const;
     
-    // Feature checking - throws MissingFeatureException if feature not available
+    // Feature checking - throws MissingFeatureException if feature not available.
+    // These, is_expired and get_available_features read an immutable snapshot
+    // of the loaded license: any number of threads may call them, wait-free,
+    // while another thread reloads.
     bool has_feature(const std::string& feature) const;
     void require_feature(const std::string& feature) const; // throws if missing
     
+    // Hot-path gating: register a feature name once, at startup, and check
+    // the handle with a single atomic load and bit test. Every reload
+    // republishes the bits of all registered features in one store.
+    // Registering a name again returns the same handle; more than
+    // MAX_REGISTERED_FEATURES distinct names throws ValidationException.
+    static constexpr size_t MAX_REGISTERED_FEATURES = 63;
+    FeatureId register_feature(const std::string& feature);
+    bool has_feature(FeatureId feature) const;
+    
+    // Literal feature names hashed at compile time (feature_name.hpp):
+    // has_feature("analytics"_feature), has_feature(LICENSECORE_FEATURE("analytics"))
+    // or, in C++20, has_feature<"analytics">(). Same result as the string
+    // overload without hashing the name per call.
+    bool has_feature(const FeatureName& feature) const;
+#ifdef LICENSECORE_HAS_FEATURE_TEMPLATE
+    template <FixedString Name>
+    bool has_feature() const {
+        static constexpr FeatureName feature(Name.view());
+        return has_feature(feature);
+    }
+#endif
+    
     // Utility methods
     std::string generate_license(const LicenseInfo& info) const;
+    
+    // Same license in a detached-signature envelope (HMACValidator::seal_envelope):
+    // the MAC covers the exact JSON bytes, so load_and_validate rejects forged
+    // input before parsing it and never rebuilds the canonical form
+    std::string generate_detached_license(const LicenseInfo& info) const;
+    
+    // Compact binary encoding of the same signed license: fixed header and
+    // length-prefixed strings, decoded without allocating or parsing text.
+    // It carries the JSON form's signature, so conversion needs no key and is
+    // lossless both ways; the converters throw MalformedLicenseException.
+    std::string generate_binary_license(const LicenseInfo& info) const;
+    static std::string binary_license_from_json(const std::string& license_json);
+    static std::string json_license_from_binary(const std::string& binary_license);
     bool is_expired() const; // throws ExpiredLicenseException if expired and strict mode enabled
     std::vector<std::string> get_available_features() const;
     std::string get_current_hwid() const; // throws HardwareDetectionException on failure
@@ -44,6 +151,18 @@ public:
     void set_hardware_config(const HardwareConfig& config);
     void set_strict_validation(bool strict = true); // If true, methods throw on invalid state
     
+    // Key rotation: each license names its key through an optional "kid" field,
+    // so one manager verifies licenses from every active key with a single lookup.
+    // The constructor key has the empty id; generate_license uses the signing key.
+    void add_key(const std::string& kid, const std::string& secret_key);
+    bool remove_key(const std::string& kid);
+    void set_signing_key(const std::string& kid);
+    
+    // Validation cache - flushed automatically when keys or hardware config change
+    void set_validation_cache(const ValidationCacheConfig& config);
+    void clear_validation_cache();
+    ValidationCacheStats get_validation_cache_stats() const;
+    
 private:
     class Impl;
     std::unique_ptr<Impl> pimpl_;
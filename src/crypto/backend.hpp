@@ -0,0 +1,24 @@
+#pragma once
+
+#include "crypto/sha256.hpp"
+#include <cstddef>
+
+// Crypto backend selected at configure time (LICENSECORE_CRYPTO_BACKEND):
+//   OpenSSL - SHA-256, HMAC and randomness from libcrypto (default)
+//   Builtin - self-contained SHA-256/HMAC (SHA-NI/AVX2 dispatch) and the OS RNG,
+//             no OpenSSL dependency; Ed25519 is unavailable
+// Exactly one of backend_openssl.cpp / backend_builtin.cpp is compiled in.
+namespace license_core {
+namespace crypto {
+
+// "openssl" or "builtin"
+const char* backend_name() noexcept;
+
+// SHA-256 of data - throws CryptographicException on failure
+Sha256Digest sha256(const void* data, size_t length);
+
+// Fill out with cryptographically secure random bytes - throws CryptographicException on failure
+void random_bytes(void* out, size_t length);
+
+} // namespace crypto
+} // namespace license_core
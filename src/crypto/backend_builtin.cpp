@@ -0,0 +1,58 @@
+#include "crypto/backend.hpp"
+#include "license_core/exceptions.hpp"
+#include <cerrno>
+#include <cstdint>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <bcrypt.h>
+    #pragma comment(lib, "bcrypt.lib")
+#elif __APPLE__
+    #include <stdlib.h> // arc4random_buf
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/random.h>
+#endif
+
+namespace license_core {
+namespace crypto {
+
+const char* backend_name() noexcept {
+    return "builtin";
+}
+
+Sha256Digest sha256(const void* data, size_t length) {
+    return Sha256::hash(data, length);
+}
+
+void random_bytes(void* out, size_t length) {
+    uint8_t* p = static_cast<uint8_t*>(out);
+#ifdef _WIN32
+    while (length > 0) {
+        ULONG chunk = length > 0xFFFFFFFFu ? 0xFFFFFFFFu : static_cast<ULONG>(length);
+        if (!BCRYPT_SUCCESS(BCryptGenRandom(nullptr, p, chunk, BCRYPT_USE_SYSTEM_PREFERRED_RNG))) {
+            throw CryptographicException("BCryptGenRandom failed");
+        }
+        p += chunk;
+        length -= chunk;
+    }
+#elif __APPLE__
+    arc4random_buf(p, length);
+#else
+    while (length > 0) {
+        ssize_t n = getrandom(p, length, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw CryptographicException("getrandom failed");
+        }
+        p += n;
+        length -= static_cast<size_t>(n);
+    }
+#endif
+}
+
+} // namespace crypto
+} // namespace license_core
@@ -0,0 +1,35 @@
+#include "crypto/backend.hpp"
+#include "license_core/exceptions.hpp"
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+#include <climits>
+
+namespace license_core {
+namespace crypto {
+
+const char* backend_name() noexcept {
+    return "openssl";
+}
+
+Sha256Digest sha256(const void* data, size_t length) {
+    Sha256Digest digest;
+    if (SHA256(static_cast<const unsigned char*>(data), length, digest.data()) == nullptr) {
+        throw CryptographicException("SHA256 hash computation failed");
+    }
+    return digest;
+}
+
+void random_bytes(void* out, size_t length) {
+    unsigned char* p = static_cast<unsigned char*>(out);
+    while (length > 0) {
+        int chunk = length > INT_MAX ? INT_MAX : static_cast<int>(length);
+        if (RAND_bytes(p, chunk) != 1) {
+            throw CryptographicException("RAND_bytes failed");
+        }
+        p += chunk;
+        length -= static_cast<size_t>(chunk);
+    }
+}
+
+} // namespace crypto
+} // namespace license_core
@@ -0,0 +1,359 @@
+#include "crypto/hmac_sha256.hpp"
+#include "license_core/exceptions.hpp"
+#ifdef LICENSECORE_CRYPTO_OPENSSL
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/opensslv.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
+#endif
+#include <cstring>
+#include <memory>
+
+namespace license_core {
+namespace crypto {
+
+#if defined(LICENSECORE_CRYPTO_OPENSSL) && OPENSSL_VERSION_NUMBER >= 0x30000000L
+
+namespace {
+
+struct MacCtxDeleter {
+    void operator()(EVP_MAC_CTX* ctx) const { EVP_MAC_CTX_free(ctx); }
+};
+using MacCtxPtr = std::unique_ptr<EVP_MAC_CTX, MacCtxDeleter>;
+
+} // namespace
+
+HmacSha256Key::HmacSha256Key(const std::string& key) {
+    EVP_MAC* mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+    if (mac == nullptr) {
+        throw CryptographicException("HMAC algorithm unavailable");
+    }
+
+    MacCtxPtr ctx(EVP_MAC_CTX_new(mac));
+    EVP_MAC_free(mac); // the context keeps its own reference
+    if (!ctx) {
+        throw CryptographicException("Failed to allocate HMAC context");
+    }
+
+    char digest_name[] = "SHA256";
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest_name, 0),
+        OSSL_PARAM_construct_end()
+    };
+
+    if (EVP_MAC_init(ctx.get(), reinterpret_cast<const unsigned char*>(key.data()),
+                     key.size(), params) != 1) {
+        throw CryptographicException("Failed to initialize HMAC key");
+    }
+
+    ctx_ = ctx.release();
+    hmac_sha256_midstates(key, inner_midstate_, outer_midstate_);
+}
+
+HmacSha256Key::~HmacSha256Key() {
+    EVP_MAC_CTX_free(static_cast<EVP_MAC_CTX*>(ctx_));
+}
+
+Sha256Digest HmacSha256Key::compute(const void* data, size_t length) const {
+    if (ctx_ == nullptr) {
+        return compute_from_midstates(static_cast<const uint8_t*>(data), length);
+    }
+
+    MacCtxPtr ctx(EVP_MAC_CTX_dup(static_cast<const EVP_MAC_CTX*>(ctx_)));
+    if (!ctx) {
+        throw CryptographicException("Failed to clone HMAC context");
+    }
+
+    Sha256Digest digest{};
+    size_t digest_len = 0;
+    if (EVP_MAC_update(ctx.get(), static_cast<const unsigned char*>(data), length) != 1 ||
+        EVP_MAC_final(ctx.get(), digest.data(), &digest_len, digest.size()) != 1 ||
+        digest_len != digest.size()) {
+        throw CryptographicException("HMAC computation failed");
+    }
+    return digest;
+}
+
+#elif defined(LICENSECORE_CRYPTO_OPENSSL) // OpenSSL 1.1
+
+namespace {
+
+struct HmacCtxDeleter {
+    void operator()(HMAC_CTX* ctx) const { HMAC_CTX_free(ctx); }
+};
+using HmacCtxPtr = std::unique_ptr<HMAC_CTX, HmacCtxDeleter>;
+
+} // namespace
+
+HmacSha256Key::HmacSha256Key(const std::string& key) {
+    HmacCtxPtr ctx(HMAC_CTX_new());
+    if (!ctx) {
+        throw CryptographicException("Failed to allocate HMAC context");
+    }
+
+    if (HMAC_Init_ex(ctx.get(), key.data(), static_cast<int>(key.size()),
+                     EVP_sha256(), nullptr) != 1) {
+        throw CryptographicException("Failed to initialize HMAC key");
+    }
+
+    ctx_ = ctx.release();
+    hmac_sha256_midstates(key, inner_midstate_, outer_midstate_);
+}
+
+HmacSha256Key::~HmacSha256Key() {
+    HMAC_CTX_free(static_cast<HMAC_CTX*>(ctx_));
+}
+
+Sha256Digest HmacSha256Key::compute(const void* data, size_t length) const {
+    if (ctx_ == nullptr) {
+        return compute_from_midstates(static_cast<const uint8_t*>(data), length);
+    }
+
+    HmacCtxPtr ctx(HMAC_CTX_new());
+    if (!ctx || HMAC_CTX_copy(ctx.get(), static_cast<HMAC_CTX*>(ctx_)) != 1) {
+        throw CryptographicException("Failed to clone HMAC context");
+    }
+
+    Sha256Digest digest{};
+    unsigned int digest_len = 0;
+    if (HMAC_Update(ctx.get(), static_cast<const unsigned char*>(data), length) != 1 ||
+        HMAC_Final(ctx.get(), digest.data(), &digest_len) != 1 ||
+        digest_len != digest.size()) {
+        throw CryptographicException("HMAC computation failed");
+    }
+    return digest;
+}
+
+#else // builtin backend: the midstates are the whole keyed state
+
+HmacSha256Key::HmacSha256Key(const std::string& key) {
+    hmac_sha256_midstates(key, inner_midstate_, outer_midstate_);
+}
+
+HmacSha256Key::~HmacSha256Key() = default;
+
+Sha256Digest HmacSha256Key::compute(const void* data, size_t length) const {
+    return compute_from_midstates(static_cast<const uint8_t*>(data), length);
+}
+
+#endif
+
+namespace {
+
+constexpr uint8_t IPAD = 0x36;
+constexpr uint8_t OPAD = 0x5c;
+
+// Every HMAC message is preceded by one block of key^ipad (or key^opad)
+constexpr uint64_t KEY_BLOCK_BYTES = SHA256_BLOCK_SIZE;
+
+void secure_zero(void* data, size_t length) {
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+    while (length--) {
+        *p++ = 0;
+    }
+}
+
+inline void store_be64(uint8_t* p, uint64_t v) {
+    for (int i = 7; i >= 0; --i) {
+        p[i] = static_cast<uint8_t>(v);
+        v >>= 8;
+    }
+}
+
+// Final outer block: inner digest, padding, and the bit length of key block + digest
+void build_outer_block(uint8_t block[SHA256_BLOCK_SIZE], const Sha256Digest& inner) {
+    std::memcpy(block, inner.data(), inner.size());
+    block[inner.size()] = 0x80;
+    std::memset(block + inner.size() + 1, 0, SHA256_BLOCK_SIZE - inner.size() - 1 - 8);
+    store_be64(block + SHA256_BLOCK_SIZE - 8, (KEY_BLOCK_BYTES + inner.size()) * 8);
+}
+
+} // namespace
+
+bool digests_equal(const Sha256Digest& a, const Sha256Digest& b) noexcept {
+    uint8_t diff = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        diff |= static_cast<uint8_t>(a[i] ^ b[i]);
+    }
+    return diff == 0;
+}
+
+void hmac_sha256_midstates(const std::string& key, Sha256State& inner, Sha256State& outer) {
+    uint8_t key_block[SHA256_BLOCK_SIZE] = {};
+    if (key.size() > SHA256_BLOCK_SIZE) {
+        auto hashed = Sha256::hash(key.data(), key.size());
+        std::memcpy(key_block, hashed.data(), hashed.size());
+    } else {
+        std::memcpy(key_block, key.data(), key.size());
+    }
+
+    uint8_t pad[SHA256_BLOCK_SIZE];
+    for (size_t i = 0; i < SHA256_BLOCK_SIZE; ++i) {
+        pad[i] = key_block[i] ^ IPAD;
+    }
+    inner = SHA256_INITIAL_STATE;
+    sha256_compress(inner, pad, 1);
+
+    for (size_t i = 0; i < SHA256_BLOCK_SIZE; ++i) {
+        pad[i] = key_block[i] ^ OPAD;
+    }
+    outer = SHA256_INITIAL_STATE;
+    sha256_compress(outer, pad, 1);
+
+    secure_zero(key_block, sizeof(key_block));
+    secure_zero(pad, sizeof(pad));
+}
+
+HmacSha256Key::HmacSha256Key(const Sha256State& inner_midstate, const Sha256State& outer_midstate) noexcept
+    : inner_midstate_(inner_midstate), outer_midstate_(outer_midstate) {
+}
+
+HmacSha256Stream::HmacSha256Stream(const HmacSha256Key& key) noexcept
+    : HmacSha256Stream(key.inner_midstate_, key.outer_midstate_) {}
+
+HmacSha256Stream::HmacSha256Stream(const Sha256State& inner_midstate, const Sha256State& outer_midstate) noexcept
+    : inner_(inner_midstate, KEY_BLOCK_BYTES),
+      outer_midstate_(outer_midstate) {}
+
+void HmacSha256Stream::update(const void* data, size_t length) noexcept {
+    inner_.update(data, length);
+}
+
+Sha256Digest HmacSha256Stream::final() noexcept {
+    auto inner_digest = inner_.final();
+
+    Sha256 outer(outer_midstate_, KEY_BLOCK_BYTES);
+    outer.update(inner_digest.data(), inner_digest.size());
+    return outer.final();
+}
+
+Sha256Digest HmacSha256Key::compute_from_midstates(const uint8_t* data, size_t length) const {
+    HmacSha256Stream stream(*this);
+    stream.update(data, length);
+    return stream.final();
+}
+
+void HmacSha256Key::verify_batch(const HmacBatchJob* jobs, size_t count, bool* results) const {
+    // Tiny batches would leave most lanes idle
+    if (sha256_has_simd_lanes() && count >= SHA256_LANES / 2) {
+        verify_batch_lanes(jobs, count, results);
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        results[i] = jobs[i].expected != nullptr &&
+                     digests_equal(compute_from_midstates(jobs[i].data, jobs[i].length),
+                                   *jobs[i].expected);
+    }
+}
+
+// Multi-buffer scheduler: each SIMD lane walks its own message block by block
+// (full blocks straight from the caller's buffer, then one or two padded tail
+// blocks, then the single outer block) and is refilled with the next job as
+// soon as it finishes, so lanes stay busy even when message lengths differ.
+void HmacSha256Key::verify_batch_lanes(const HmacBatchJob* jobs, size_t count, bool* results) const {
+    struct Lane {
+        size_t job = 0;
+        const uint8_t* next = nullptr;
+        size_t full_blocks = 0;
+        size_t tail_blocks = 0;
+        size_t tail_offset = 0;
+        bool outer = false;
+        bool active = false;
+        uint8_t tail[2 * SHA256_BLOCK_SIZE];
+    };
+
+    Lane lanes[SHA256_LANES];
+    Sha256State states[SHA256_LANES] = {};
+    const uint8_t* blocks[SHA256_LANES];
+    size_t next_job = 0;
+
+    auto start_job = [&](Lane& lane, Sha256State& state) {
+        while (next_job < count) {
+            const HmacBatchJob& job = jobs[next_job];
+            size_t index = next_job++;
+            if (job.expected == nullptr) {
+                results[index] = false;
+                continue;
+            }
+
+            size_t remainder = job.length % SHA256_BLOCK_SIZE;
+            lane.job = index;
+            lane.next = job.data;
+            lane.full_blocks = job.length / SHA256_BLOCK_SIZE;
+            lane.tail_blocks = remainder + 9 <= SHA256_BLOCK_SIZE ? 1 : 2;
+            lane.tail_offset = 0;
+            lane.outer = false;
+            lane.active = true;
+
+            size_t tail_size = lane.tail_blocks * SHA256_BLOCK_SIZE;
+            if (remainder > 0) {
+                std::memcpy(lane.tail, job.data + lane.full_blocks * SHA256_BLOCK_SIZE, remainder);
+            }
+            lane.tail[remainder] = 0x80;
+            std::memset(lane.tail + remainder + 1, 0, tail_size - remainder - 1 - 8);
+            store_be64(lane.tail + tail_size - 8, (KEY_BLOCK_BYTES + job.length) * 8);
+
+            state = inner_midstate_;
+            return;
+        }
+        lane.active = false;
+    };
+
+    for (size_t i = 0; i < SHA256_LANES; ++i) {
+        start_job(lanes[i], states[i]);
+    }
+
+    for (;;) {
+        bool any_active = false;
+        for (size_t i = 0; i < SHA256_LANES; ++i) {
+            Lane& lane = lanes[i];
+            if (!lane.active) {
+                blocks[i] = nullptr;
+                continue;
+            }
+            any_active = true;
+            blocks[i] = lane.full_blocks > 0 ? lane.next : lane.tail + lane.tail_offset;
+        }
+        if (!any_active) {
+            break;
+        }
+
+        sha256_compress_lanes(states, blocks);
+
+        for (size_t i = 0; i < SHA256_LANES; ++i) {
+            Lane& lane = lanes[i];
+            if (!lane.active) {
+                continue;
+            }
+
+            if (lane.outer) {
+                results[lane.job] = digests_equal(sha256_state_to_digest(states[i]),
+                                                  *jobs[lane.job].expected);
+                start_job(lane, states[i]);
+                continue;
+            }
+
+            if (lane.full_blocks > 0) {
+                --lane.full_blocks;
+                lane.next += SHA256_BLOCK_SIZE;
+            } else {
+                --lane.tail_blocks;
+                lane.tail_offset += SHA256_BLOCK_SIZE;
+            }
+
+            if (lane.full_blocks == 0 && lane.tail_blocks == 0) {
+                build_outer_block(lane.tail, sha256_state_to_digest(states[i]));
+                lane.tail_offset = 0;
+                lane.outer = true;
+                states[i] = outer_midstate_;
+            }
+        }
+    }
+}
+
+} // namespace crypto
+} // namespace license_core
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "crypto/sha256.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace license_core {
+namespace crypto {
+
+// One message of a batch verification. A null expected digest marks an item
+// that is already known to be invalid; it is reported as false without hashing.
+struct HmacBatchJob {
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    const Sha256Digest* expected = nullptr;
+};
+
+// Constant-time digest comparison
+bool digests_equal(const Sha256Digest& a, const Sha256Digest& b) noexcept;
+
+class HmacSha256Key;
+
+// Reduce an HMAC key to the SHA-256 chaining values after key^ipad / key^opad.
+// These two states are all later computations need; the key itself is not kept.
+void hmac_sha256_midstates(const std::string& key, Sha256State& inner, Sha256State& outer);
+
+// Incremental HMAC-SHA256 resumed from a key's prepared midstates. Holds no
+// pointers or heap state, so it can be copied to fork a common prefix.
+class HmacSha256Stream {
+public:
+    explicit HmacSha256Stream(const HmacSha256Key& key) noexcept;
+    HmacSha256Stream(const Sha256State& inner_midstate, const Sha256State& outer_midstate) noexcept;
+
+    void update(const void* data, size_t length) noexcept;
+    Sha256Digest final() noexcept;
+
+private:
+    Sha256 inner_;
+    Sha256State outer_midstate_;
+};
+
+// HMAC-SHA256 key with the keyed state (digest fetch, key hash, ipad/opad)
+// prepared once. Each computation clones that state instead of rebuilding it,
+// so the per-call cost is proportional to the message only.
+// Immutable after construction and safe to share between threads.
+class HmacSha256Key {
+public:
+    explicit HmacSha256Key(const std::string& key);
+    // Key known only by its midstates (e.g. embedded at build time); always
+    // computed with the builtin SHA-256, whatever the backend
+    HmacSha256Key(const Sha256State& inner_midstate, const Sha256State& outer_midstate) noexcept;
+    ~HmacSha256Key();
+
+    HmacSha256Key(const HmacSha256Key&) = delete;
+    HmacSha256Key& operator=(const HmacSha256Key&) = delete;
+
+    // Compute HMAC-SHA256(key, data) - throws CryptographicException on failure
+    Sha256Digest compute(const void* data, size_t length) const;
+
+    // Verify count independent messages, writing one result per job. Messages
+    // are hashed several at a time in SIMD lanes when the CPU supports it.
+    void verify_batch(const HmacBatchJob* jobs, size_t count, bool* results) const;
+
+private:
+    friend class HmacSha256Stream;
+
+    // EVP_MAC_CTX* (OpenSSL 3) or HMAC_CTX* (OpenSSL 1.1); null for the builtin
+    // backend and midstate-only keys
+    void* ctx_ = nullptr;
+
+    // SHA-256 chaining values after absorbing key^ipad and key^opad
+    Sha256State inner_midstate_;
+    Sha256State outer_midstate_;
+
+    Sha256Digest compute_from_midstates(const uint8_t* data, size_t length) const;
+    void verify_batch_lanes(const HmacBatchJob* jobs, size_t count, bool* results) const;
+};
+
+} // namespace crypto
+} // namespace license_core
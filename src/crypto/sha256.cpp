@@ -0,0 +1,408 @@
+#include "crypto/sha256.hpp"
+#include "simd/cpu_features.hpp"
+#include <cstring>
+
+#if defined(LICENSECORE_X86)
+#include <immintrin.h>
+#endif
+
+namespace license_core {
+namespace crypto {
+
+const Sha256State SHA256_INITIAL_STATE = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+namespace {
+
+alignas(16) const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t load_be32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+inline void store_be32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v >> 24);
+    p[1] = static_cast<uint8_t>(v >> 16);
+    p[2] = static_cast<uint8_t>(v >> 8);
+    p[3] = static_cast<uint8_t>(v);
+}
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+using CompressFn = void (*)(Sha256State&, const uint8_t*, size_t);
+
+CompressFn select_compress() {
+    return simd::cpu_features().sha ? detail::sha256_compress_shani
+                                    : detail::sha256_compress_scalar;
+}
+
+} // namespace
+
+namespace detail {
+
+void sha256_compress_scalar(Sha256State& state, const uint8_t* blocks, size_t block_count) {
+    uint32_t w[64];
+
+    for (; block_count > 0; --block_count, blocks += SHA256_BLOCK_SIZE) {
+        for (int t = 0; t < 16; ++t) {
+            w[t] = load_be32(blocks + 4 * t);
+        }
+        for (int t = 16; t < 64; ++t) {
+            uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int t = 0; t < 64; ++t) {
+            uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + ch + K[t] + w[t];
+            uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+#if defined(LICENSECORE_X86)
+
+namespace {
+
+// SHA-NI rounds for N independent streams. Interleaving the streams hides
+// the latency of the dependent sha256rnds2 chain; N == 1 is the plain kernel.
+template <size_t N>
+LICENSECORE_TARGET("sha,sse4.1")
+inline void shani_compress_streams(Sha256State* const states[N], const uint8_t* const blocks[N],
+                                   size_t block_count) {
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0[N];
+    __m128i state1[N];
+    const uint8_t* data[N];
+
+    // Rearrange H0..H7 into the ABEF / CDGH register layout sha256rnds2 expects
+    for (size_t n = 0; n < N; ++n) {
+        __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&(*states[n])[0]));
+        __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&(*states[n])[4]));
+        tmp = _mm_shuffle_epi32(tmp, 0xB1);
+        s1 = _mm_shuffle_epi32(s1, 0x1B);
+        state0[n] = _mm_alignr_epi8(tmp, s1, 8);
+        state1[n] = _mm_blend_epi16(s1, tmp, 0xF0);
+        data[n] = blocks[n];
+    }
+
+    for (; block_count > 0; --block_count) {
+        __m128i abef_save[N];
+        __m128i cdgh_save[N];
+        __m128i msg[N][4];
+        for (size_t n = 0; n < N; ++n) {
+            abef_save[n] = state0[n];
+            cdgh_save[n] = state1[n];
+        }
+
+        // 16 groups of 4 rounds; msg[n][i % 4] holds W[4i..4i+3] when group i runs.
+        // Fully unrolled so the schedule indices fold and msg stays in registers.
+#if defined(__clang__)
+#pragma clang loop unroll(full)
+#elif defined(__GNUC__)
+#pragma GCC unroll 16
+#endif
+        for (int i = 0; i < 16; ++i) {
+            const __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(&K[4 * i]));
+            for (size_t n = 0; n < N; ++n) {
+                if (i < 4) {
+                    msg[n][i] = _mm_shuffle_epi8(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data[n] + 16 * i)), byte_swap);
+                }
+
+                __m128i wk = _mm_add_epi32(msg[n][i % 4], k);
+                state1[n] = _mm_sha256rnds2_epu32(state1[n], state0[n], wk);
+
+                if (i >= 3 && i < 15) {
+                    __m128i& next = msg[n][(i + 1) % 4];
+                    next = _mm_add_epi32(next, _mm_alignr_epi8(msg[n][i % 4], msg[n][(i + 3) % 4], 4));
+                    next = _mm_sha256msg2_epu32(next, msg[n][i % 4]);
+                }
+
+                wk = _mm_shuffle_epi32(wk, 0x0E);
+                state0[n] = _mm_sha256rnds2_epu32(state0[n], state1[n], wk);
+
+                if (i >= 1 && i < 13) {
+                    msg[n][(i + 3) % 4] = _mm_sha256msg1_epu32(msg[n][(i + 3) % 4], msg[n][i % 4]);
+                }
+            }
+        }
+
+        for (size_t n = 0; n < N; ++n) {
+            state0[n] = _mm_add_epi32(state0[n], abef_save[n]);
+            state1[n] = _mm_add_epi32(state1[n], cdgh_save[n]);
+            data[n] += SHA256_BLOCK_SIZE;
+        }
+    }
+
+    for (size_t n = 0; n < N; ++n) {
+        __m128i tmp = _mm_shuffle_epi32(state0[n], 0x1B);
+        __m128i s1 = _mm_shuffle_epi32(state1[n], 0xB1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&(*states[n])[0]), _mm_blend_epi16(tmp, s1, 0xF0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&(*states[n])[4]), _mm_alignr_epi8(s1, tmp, 8));
+    }
+}
+
+} // namespace
+
+LICENSECORE_TARGET("sha,sse4.1")
+void sha256_compress_shani(Sha256State& state, const uint8_t* blocks, size_t block_count) {
+    Sha256State* const states[1] = {&state};
+    const uint8_t* const data[1] = {blocks};
+    shani_compress_streams<1>(states, data, block_count);
+}
+
+LICENSECORE_TARGET("sha,sse4.1")
+void sha256_compress_x2_shani(Sha256State& first, const uint8_t* first_block,
+                              Sha256State& second, const uint8_t* second_block) {
+    Sha256State* const states[2] = {&first, &second};
+    const uint8_t* const data[2] = {first_block, second_block};
+    shani_compress_streams<2>(states, data, 1);
+}
+
+namespace {
+
+LICENSECORE_TARGET("avx2")
+inline __m256i rotr8(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+} // namespace
+
+LICENSECORE_TARGET("avx2")
+void sha256_compress_x8_avx2(Sha256State states[SHA256_LANES],
+                             const uint8_t* const blocks[SHA256_LANES]) {
+    // Lane j of every vector belongs to message j
+    __m256i w[64];
+    for (int t = 0; t < 16; ++t) {
+        w[t] = _mm256_setr_epi32(
+            static_cast<int>(load_be32(blocks[0] + 4 * t)), static_cast<int>(load_be32(blocks[1] + 4 * t)),
+            static_cast<int>(load_be32(blocks[2] + 4 * t)), static_cast<int>(load_be32(blocks[3] + 4 * t)),
+            static_cast<int>(load_be32(blocks[4] + 4 * t)), static_cast<int>(load_be32(blocks[5] + 4 * t)),
+            static_cast<int>(load_be32(blocks[6] + 4 * t)), static_cast<int>(load_be32(blocks[7] + 4 * t)));
+    }
+    for (int t = 16; t < 64; ++t) {
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w[t - 15], 7), rotr8(w[t - 15], 18)),
+                                      _mm256_srli_epi32(w[t - 15], 3));
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w[t - 2], 17), rotr8(w[t - 2], 19)),
+                                      _mm256_srli_epi32(w[t - 2], 10));
+        w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0), _mm256_add_epi32(w[t - 7], s1));
+    }
+
+    __m256i v[8];
+    for (int i = 0; i < 8; ++i) {
+        v[i] = _mm256_setr_epi32(
+            static_cast<int>(states[0][i]), static_cast<int>(states[1][i]),
+            static_cast<int>(states[2][i]), static_cast<int>(states[3][i]),
+            static_cast<int>(states[4][i]), static_cast<int>(states[5][i]),
+            static_cast<int>(states[6][i]), static_cast<int>(states[7][i]));
+    }
+
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3];
+    __m256i e = v[4], f = v[5], g = v[6], h = v[7];
+
+    for (int t = 0; t < 64; ++t) {
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(e, 6), rotr8(e, 11)), rotr8(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, s1),
+                                      _mm256_add_epi32(ch, _mm256_add_epi32(
+                                          w[t], _mm256_set1_epi32(static_cast<int>(K[t])))));
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(a, 2), rotr8(a, 13)), rotr8(a, 22));
+        __m256i maj = _mm256_xor_si256(_mm256_and_si256(a, b),
+                                       _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+        __m256i t2 = _mm256_add_epi32(s0, maj);
+        h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+        d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+    }
+
+    v[0] = _mm256_add_epi32(v[0], a); v[1] = _mm256_add_epi32(v[1], b);
+    v[2] = _mm256_add_epi32(v[2], c); v[3] = _mm256_add_epi32(v[3], d);
+    v[4] = _mm256_add_epi32(v[4], e); v[5] = _mm256_add_epi32(v[5], f);
+    v[6] = _mm256_add_epi32(v[6], g); v[7] = _mm256_add_epi32(v[7], h);
+
+    alignas(32) uint32_t out[8];
+    for (int i = 0; i < 8; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out), v[i]);
+        for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+            states[lane][i] = out[lane];
+        }
+    }
+}
+
+#else
+
+void sha256_compress_shani(Sha256State& state, const uint8_t* blocks, size_t block_count) {
+    sha256_compress_scalar(state, blocks, block_count);
+}
+
+void sha256_compress_x2_shani(Sha256State& first, const uint8_t* first_block,
+                              Sha256State& second, const uint8_t* second_block) {
+    sha256_compress_scalar(first, first_block, 1);
+    sha256_compress_scalar(second, second_block, 1);
+}
+
+void sha256_compress_x8_avx2(Sha256State states[SHA256_LANES],
+                             const uint8_t* const blocks[SHA256_LANES]) {
+    for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        sha256_compress_scalar(states[lane], blocks[lane], 1);
+    }
+}
+
+#endif
+
+} // namespace detail
+
+void sha256_compress(Sha256State& state, const uint8_t* blocks, size_t block_count) {
+    static const CompressFn compress = select_compress();
+    compress(state, blocks, block_count);
+}
+
+bool sha256_has_simd_lanes() noexcept {
+    const auto& cpu = simd::cpu_features();
+    return cpu.sha || cpu.avx2;
+}
+
+void sha256_compress_lanes(Sha256State states[SHA256_LANES],
+                           const uint8_t* const blocks[SHA256_LANES]) {
+    const auto& cpu = simd::cpu_features();
+
+    // SHA-NI in interleaved pairs beats the 8-wide AVX2 rounds and can skip idle lanes
+    if (cpu.sha) {
+        size_t lane = 0;
+        while (lane < SHA256_LANES) {
+            if (blocks[lane] == nullptr) {
+                ++lane;
+                continue;
+            }
+            size_t partner = lane + 1;
+            while (partner < SHA256_LANES && blocks[partner] == nullptr) {
+                ++partner;
+            }
+            if (partner == SHA256_LANES) {
+                detail::sha256_compress_shani(states[lane], blocks[lane], 1);
+                break;
+            }
+            detail::sha256_compress_x2_shani(states[lane], blocks[lane], states[partner], blocks[partner]);
+            lane = partner + 1;
+        }
+        return;
+    }
+
+    if (cpu.avx2) {
+        static const uint8_t idle_block[SHA256_BLOCK_SIZE] = {};
+        const uint8_t* lane_blocks[SHA256_LANES];
+        for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+            lane_blocks[lane] = blocks[lane] != nullptr ? blocks[lane] : idle_block;
+        }
+        detail::sha256_compress_x8_avx2(states, lane_blocks);
+        return;
+    }
+
+    for (size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        if (blocks[lane] != nullptr) {
+            detail::sha256_compress_scalar(states[lane], blocks[lane], 1);
+        }
+    }
+}
+
+Sha256Digest sha256_state_to_digest(const Sha256State& state) noexcept {
+    Sha256Digest digest;
+    for (size_t i = 0; i < state.size(); ++i) {
+        store_be32(digest.data() + 4 * i, state[i]);
+    }
+    return digest;
+}
+
+Sha256::Sha256() noexcept
+    : state_(SHA256_INITIAL_STATE) {
+}
+
+Sha256::Sha256(const Sha256State& midstate, uint64_t bytes_already_hashed) noexcept
+    : state_(midstate), total_(bytes_already_hashed) {
+}
+
+void Sha256::update(const void* data, size_t length) noexcept {
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+    total_ += length;
+
+    if (buffered_ > 0) {
+        size_t take = SHA256_BLOCK_SIZE - buffered_;
+        if (take > length) {
+            take = length;
+        }
+        std::memcpy(buffer_ + buffered_, input, take);
+        buffered_ += take;
+        input += take;
+        length -= take;
+        if (buffered_ < SHA256_BLOCK_SIZE) {
+            return;
+        }
+        sha256_compress(state_, buffer_, 1);
+        buffered_ = 0;
+    }
+
+    size_t full_blocks = length / SHA256_BLOCK_SIZE;
+    if (full_blocks > 0) {
+        sha256_compress(state_, input, full_blocks);
+        input += full_blocks * SHA256_BLOCK_SIZE;
+        length -= full_blocks * SHA256_BLOCK_SIZE;
+    }
+
+    if (length > 0) {
+        std::memcpy(buffer_, input, length);
+        buffered_ = length;
+    }
+}
+
+Sha256Digest Sha256::final() noexcept {
+    const uint64_t bit_length = total_ * 8;
+
+    buffer_[buffered_++] = 0x80;
+    if (buffered_ > SHA256_BLOCK_SIZE - 8) {
+        std::memset(buffer_ + buffered_, 0, SHA256_BLOCK_SIZE - buffered_);
+        sha256_compress(state_, buffer_, 1);
+        buffered_ = 0;
+    }
+    std::memset(buffer_ + buffered_, 0, SHA256_BLOCK_SIZE - 8 - buffered_);
+    store_be32(buffer_ + SHA256_BLOCK_SIZE - 8, static_cast<uint32_t>(bit_length >> 32));
+    store_be32(buffer_ + SHA256_BLOCK_SIZE - 4, static_cast<uint32_t>(bit_length));
+    sha256_compress(state_, buffer_, 1);
+    buffered_ = 0;
+
+    return sha256_state_to_digest(state_);
+}
+
+Sha256Digest Sha256::hash(const void* data, size_t length) noexcept {
+    Sha256 sha;
+    sha.update(data, length);
+    return sha.final();
+}
+
+} // namespace crypto
+} // namespace license_core
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace license_core {
+namespace crypto {
+
+constexpr size_t SHA256_BLOCK_SIZE = 64;
+constexpr size_t SHA256_DIGEST_SIZE = 32;
+constexpr size_t SHA256_LANES = 8;
+
+using Sha256Digest = std::array<uint8_t, SHA256_DIGEST_SIZE>;
+
+// Chaining value (H0..H7). Captured on a block boundary it is a "midstate"
+// that lets a hash resume without reprocessing the bytes already absorbed.
+using Sha256State = std::array<uint32_t, 8>;
+
+extern const Sha256State SHA256_INITIAL_STATE;
+
+// Compress whole 64-byte blocks into state, using SHA-NI when available
+void sha256_compress(Sha256State& state, const uint8_t* blocks, size_t block_count);
+
+// Compress one block for each of SHA256_LANES independent states; a null block
+// pointer marks an idle lane whose state is left unchanged. Runs SHA-NI two
+// streams at a time, else the AVX2 8-lane kernel, else scalar per lane.
+void sha256_compress_lanes(Sha256State states[SHA256_LANES],
+                           const uint8_t* const blocks[SHA256_LANES]);
+
+// True when sha256_compress_lanes processes lanes in parallel (SHA-NI or AVX2)
+bool sha256_has_simd_lanes() noexcept;
+
+// Incremental SHA-256 that can start from the IV or from a midstate
+class Sha256 {
+public:
+    Sha256() noexcept;
+    Sha256(const Sha256State& midstate, uint64_t bytes_already_hashed) noexcept;
+
+    void update(const void* data, size_t length) noexcept;
+    Sha256Digest final() noexcept;
+
+    static Sha256Digest hash(const void* data, size_t length) noexcept;
+
+private:
+    Sha256State state_;
+    uint8_t buffer_[SHA256_BLOCK_SIZE];
+    size_t buffered_ = 0;
+    uint64_t total_ = 0;
+};
+
+// Big-endian serialization of a final chaining value
+Sha256Digest sha256_state_to_digest(const Sha256State& state) noexcept;
+
+// Individual kernels, exposed for tests and benchmarks. The SIMD ones must only
+// be called when simd::cpu_features() reports the matching extension.
+namespace detail {
+void sha256_compress_scalar(Sha256State& state, const uint8_t* blocks, size_t block_count);
+void sha256_compress_shani(Sha256State& state, const uint8_t* blocks, size_t block_count);
+void sha256_compress_x2_shani(Sha256State& first, const uint8_t* first_block,
+                              Sha256State& second, const uint8_t* second_block);
+void sha256_compress_x8_avx2(Sha256State states[SHA256_LANES],
+                             const uint8_t* const blocks[SHA256_LANES]);
+} // namespace detail
+
+} // namespace crypto
+} // namespace license_core
@@ -0,0 +1,326 @@
+#include "license_core/ed25519_validator.hpp"
+#include "json/simple_json.hpp"
+#include "simd/hex.hpp"
+#ifdef LICENSECORE_CRYPTO_OPENSSL
+#include <openssl/evp.h>
+#endif
+
+namespace license_core {
+
+namespace {
+
+constexpr const char* SIGNATURE_FIELD = "ed25519_signature";
+
+} // namespace
+
+// Backend-specific key handling. Everything outside Impl is backend neutral.
+class Ed25519Validator::Impl {
+public:
+    PublicKey public_key{};
+    bool has_private_key = false;
+
+    static std::shared_ptr<Impl> from_public_key(const PublicKey& public_key);
+    static std::shared_ptr<Impl> from_private_key(const PrivateKey& private_key);
+    static KeyPair generate();
+
+    Signature sign(std::string_view data) const;
+
+    // Verification context reused across messages
+    class Verifier {
+    public:
+        explicit Verifier(const Impl& impl);
+        bool verify(std::string_view data, const Signature& signature);
+
+    private:
+        const Impl& impl_;
+#ifdef LICENSECORE_CRYPTO_OPENSSL
+        std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx_;
+#endif
+    };
+
+#ifdef LICENSECORE_CRYPTO_OPENSSL
+    std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key{nullptr, &EVP_PKEY_free};
+#endif
+};
+
+#ifdef LICENSECORE_CRYPTO_OPENSSL
+
+namespace {
+
+void secure_zero(void* data, size_t length) {
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+    while (length--) {
+        *p++ = 0;
+    }
+}
+
+} // namespace
+
+bool Ed25519Validator::is_available() noexcept {
+    return true;
+}
+
+std::shared_ptr<Ed25519Validator::Impl> Ed25519Validator::Impl::from_public_key(const PublicKey& public_key) {
+    auto impl = std::make_shared<Impl>();
+    impl->key.reset(EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr,
+                                                public_key.data(), public_key.size()));
+    if (!impl->key) {
+        throw CryptographicException("Invalid Ed25519 public key");
+    }
+    impl->public_key = public_key;
+    return impl;
+}
+
+std::shared_ptr<Ed25519Validator::Impl> Ed25519Validator::Impl::from_private_key(const PrivateKey& private_key) {
+    auto impl = std::make_shared<Impl>();
+    impl->key.reset(EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr,
+                                                 private_key.data(), private_key.size()));
+    if (!impl->key) {
+        throw CryptographicException("Invalid Ed25519 private key");
+    }
+
+    size_t public_len = impl->public_key.size();
+    if (EVP_PKEY_get_raw_public_key(impl->key.get(), impl->public_key.data(), &public_len) != 1 ||
+        public_len != impl->public_key.size()) {
+        throw CryptographicException("Failed to derive Ed25519 public key");
+    }
+    impl->has_private_key = true;
+    return impl;
+}
+
+Ed25519Validator::KeyPair Ed25519Validator::Impl::generate() {
+    std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(
+        EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, nullptr), &EVP_PKEY_CTX_free);
+    EVP_PKEY* raw = nullptr;
+    if (!ctx || EVP_PKEY_keygen_init(ctx.get()) != 1 || EVP_PKEY_keygen(ctx.get(), &raw) != 1) {
+        throw CryptographicException("Ed25519 key generation failed");
+    }
+    std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key(raw, &EVP_PKEY_free);
+
+    KeyPair pair;
+    size_t public_len = pair.public_key.size();
+    size_t private_len = pair.private_key.size();
+    if (EVP_PKEY_get_raw_public_key(key.get(), pair.public_key.data(), &public_len) != 1 ||
+        EVP_PKEY_get_raw_private_key(key.get(), pair.private_key.data(), &private_len) != 1 ||
+        public_len != pair.public_key.size() || private_len != pair.private_key.size()) {
+        secure_zero(pair.private_key.data(), pair.private_key.size());
+        throw CryptographicException("Failed to export Ed25519 key pair");
+    }
+    return pair;
+}
+
+Ed25519Validator::Signature Ed25519Validator::Impl::sign(std::string_view data) const {
+    std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+    Signature signature{};
+    size_t signature_len = signature.size();
+    if (!ctx ||
+        EVP_DigestSignInit(ctx.get(), nullptr, nullptr, nullptr, key.get()) != 1 ||
+        EVP_DigestSign(ctx.get(), signature.data(), &signature_len,
+                       reinterpret_cast<const unsigned char*>(data.data()), data.size()) != 1 ||
+        signature_len != signature.size()) {
+        throw CryptographicException("Ed25519 signing failed");
+    }
+    return signature;
+}
+
+Ed25519Validator::Impl::Verifier::Verifier(const Impl& impl)
+    : impl_(impl), ctx_(EVP_MD_CTX_new(), &EVP_MD_CTX_free) {
+    if (!ctx_) {
+        throw CryptographicException("Failed to allocate Ed25519 context");
+    }
+}
+
+bool Ed25519Validator::Impl::Verifier::verify(std::string_view data, const Signature& signature) {
+    EVP_MD_CTX_reset(ctx_.get());
+    if (EVP_DigestVerifyInit(ctx_.get(), nullptr, nullptr, nullptr, impl_.key.get()) != 1) {
+        throw CryptographicException("Failed to initialize Ed25519 verification");
+    }
+    // 1 = valid, 0 = bad signature, <0 = malformed input; only 1 verifies
+    return EVP_DigestVerify(ctx_.get(), signature.data(), signature.size(),
+                            reinterpret_cast<const unsigned char*>(data.data()),
+                            data.size()) == 1;
+}
+
+#else // builtin backend has no Ed25519; no Impl can be constructed
+
+namespace {
+
+[[noreturn]] void throw_unavailable() {
+    throw CryptographicException("Ed25519 requires the OpenSSL crypto backend");
+}
+
+} // namespace
+
+bool Ed25519Validator::is_available() noexcept {
+    return false;
+}
+
+std::shared_ptr<Ed25519Validator::Impl> Ed25519Validator::Impl::from_public_key(const PublicKey&) {
+    throw_unavailable();
+}
+
+std::shared_ptr<Ed25519Validator::Impl> Ed25519Validator::Impl::from_private_key(const PrivateKey&) {
+    throw_unavailable();
+}
+
+Ed25519Validator::KeyPair Ed25519Validator::Impl::generate() {
+    throw_unavailable();
+}
+
+Ed25519Validator::Signature Ed25519Validator::Impl::sign(std::string_view) const {
+    throw_unavailable();
+}
+
+Ed25519Validator::Impl::Verifier::Verifier(const Impl& impl) : impl_(impl) {
+    throw_unavailable();
+}
+
+bool Ed25519Validator::Impl::Verifier::verify(std::string_view, const Signature&) {
+    throw_unavailable();
+}
+
+#endif
+
+Ed25519Validator::Ed25519Validator(std::shared_ptr<const Impl> impl)
+    : impl_(std::move(impl)) {
+}
+
+Ed25519Validator::Ed25519Validator(const PublicKey& public_key)
+    : impl_(Impl::from_public_key(public_key)) {
+}
+
+Ed25519Validator Ed25519Validator::from_private_key(const PrivateKey& private_key) {
+    return Ed25519Validator(Impl::from_private_key(private_key));
+}
+
+Ed25519Validator::KeyPair Ed25519Validator::generate_key_pair() {
+    return Impl::generate();
+}
+
+bool Ed25519Validator::can_sign() const {
+    return impl_->has_private_key;
+}
+
+const Ed25519Validator::PublicKey& Ed25519Validator::public_key() const {
+    return impl_->public_key;
+}
+
+Ed25519Validator::Signature Ed25519Validator::sign_raw(std::string_view data) const {
+    if (!impl_->has_private_key) {
+        throw CryptographicException("Ed25519 validator has no private key");
+    }
+    if (data.empty()) {
+        throw CryptographicException("Cannot sign empty data");
+    }
+
+    return impl_->sign(data);
+}
+
+bool Ed25519Validator::verify_raw(std::string_view data, const Signature& signature) const {
+    if (data.empty()) {
+        throw CryptographicException("Cannot verify empty data");
+    }
+
+    Impl::Verifier verifier(*impl_);
+    return verifier.verify(data, signature);
+}
+
+std::string Ed25519Validator::sign(const std::string& data) const {
+    Signature signature = sign_raw(data);
+    return simd::hex_encode(signature.data(), signature.size());
+}
+
+bool Ed25519Validator::verify(const std::string& data, const std::string& signature) const {
+    if (data.empty()) {
+        throw CryptographicException("Cannot verify empty data");
+    }
+
+    if (signature.empty()) {
+        throw InvalidSignatureException("Signature cannot be empty");
+    }
+
+    // Malformed hex can never be a valid signature
+    Signature decoded;
+    if (!decode_signature(signature, decoded)) {
+        return false;
+    }
+
+    return verify_raw(data, decoded);
+}
+
+void Ed25519Validator::verify_or_throw(const std::string& data, const std::string& signature) const {
+    if (!verify(data, signature)) {
+        throw InvalidSignatureException("Ed25519 signature verification failed");
+    }
+}
+
+// OpenSSL has no Ed25519 batch equation, so items are verified one by one; the
+// batch saves the per-call context allocation and hex handling overhead.
+std::vector<bool> Ed25519Validator::verify_batch(const BatchItem* items, size_t count) const {
+    std::vector<bool> results(count, false);
+    if (count == 0) {
+        return results;
+    }
+
+    Impl::Verifier verifier(*impl_);
+    Signature signature;
+    for (size_t i = 0; i < count; ++i) {
+        const BatchItem& item = items[i];
+        if (item.data.empty() || !decode_signature(item.signature, signature)) {
+            continue;
+        }
+        results[i] = verifier.verify(item.data, signature);
+    }
+    return results;
+}
+
+std::vector<bool> Ed25519Validator::verify_batch(const std::vector<BatchItem>& items) const {
+    return verify_batch(items.data(), items.size());
+}
+
+bool Ed25519Validator::decode_signature(std::string_view hex, Signature& out) noexcept {
+    if (hex.size() != SIGNATURE_SIZE * 2) {
+        return false;
+    }
+
+    return simd::hex_decode(hex.data(), SIGNATURE_SIZE, out.data());
+}
+
+std::string Ed25519Validator::sign_json(const std::string& json_without_signature) const {
+    if (json_without_signature.empty()) {
+        throw JsonParsingException("Cannot sign empty JSON");
+    }
+
+    try {
+        // Re-stringify to ensure consistent formatting
+        auto parsed = json::SimpleJson::parse(json_without_signature);
+        return sign(json::SimpleJson::stringify(parsed));
+    } catch (const LicenseException&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw JsonParsingException("JSON signing failed: " + std::string(e.what()));
+    }
+}
+
+bool Ed25519Validator::verify_json(const std::string& json_with_signature) const {
+    if (json_with_signature.empty()) {
+        throw JsonParsingException("Cannot verify empty JSON");
+    }
+
+    try {
+        auto parsed = json::SimpleJson::parse(json_with_signature);
+        if (!json::SimpleJson::has_key(parsed, SIGNATURE_FIELD)) {
+            throw JsonParsingException("JSON missing ed25519_signature field");
+        }
+
+        std::string signature = json::SimpleJson::get_string(parsed, SIGNATURE_FIELD);
+        parsed.erase(SIGNATURE_FIELD);
+        return verify(json::SimpleJson::stringify(parsed), signature);
+    } catch (const LicenseException&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw JsonParsingException("JSON verification failed: " + std::string(e.what()));
+    }
+}
+
+} // namespace license_core
@@ -0,0 +1,23 @@
+#include "embedded/embedded_license.hpp"
+#include "crypto/hmac_sha256.hpp"
+
+namespace license_core {
+namespace embedded {
+
+bool verify_signature_and_expiry(const EmbeddedKey& key, const EmbeddedLicense& license,
+                                 int64_t now_unix) noexcept {
+    if (license.payload == nullptr || license.payload_size == 0) {
+        return false;
+    }
+
+    crypto::HmacSha256Stream mac(key.inner_midstate, key.outer_midstate);
+    mac.update(license.payload, license.payload_size);
+    if (!crypto::digests_equal(mac.final(), license.signature)) {
+        return false;
+    }
+
+    return now_unix <= license.expiry_unix;
+}
+
+} // namespace embedded
+} // namespace license_core
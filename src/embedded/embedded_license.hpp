@@ -0,0 +1,39 @@
+#pragma once
+
+#include "crypto/sha256.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace license_core {
+namespace embedded {
+
+// HMAC key as emitted by tools/embed_key_gen: midstates only, never the secret
+struct EmbeddedKey {
+    crypto::Sha256State inner_midstate;
+    crypto::Sha256State outer_midstate;
+};
+
+// License reduced at build time to what validation needs: the canonical signed
+// payload (exactly the bytes the signature covers), the decoded signature, the
+// expiry as Unix seconds, the bound hardware hash and the feature list.
+struct EmbeddedLicense {
+    const char* payload;
+    size_t payload_size;
+    crypto::Sha256Digest signature;
+    int64_t expiry_unix;
+    const char* hardware_hash;
+    const char* const* features;
+    size_t feature_count;
+};
+
+// Defined by the generated source (embedded_key.cpp in the build tree)
+extern const EmbeddedKey KEY;
+extern const EmbeddedLicense* const LICENSE; // null when no license was embedded
+
+// Signature and expiry check straight from the midstates: no key schedule,
+// no parsing and no heap allocation. Hardware binding is checked by the caller.
+bool verify_signature_and_expiry(const EmbeddedKey& key, const EmbeddedLicense& license,
+                                 int64_t now_unix) noexcept;
+
+} // namespace embedded
+} // namespace license_core
@@ -0,0 +1,133 @@
+#include "license_core/license_core_pure_c.h"
+#include "license_core/license_manager.hpp"
+#include "embedded/embedded_license.hpp"
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <string>
+
+using namespace license_core;
+
+namespace {
+
+// Which license lc_has_feature() answers for
+enum class LoadedLicense { None, Json, Embedded };
+
+// Everything the embedded path keeps: no manager, no key ring, no snapshot.
+// The fingerprint is a SHA-256 hex digest held in a fixed buffer.
+struct PureCState {
+    std::mutex mutex;
+    LoadedLicense loaded = LoadedLicense::None;
+    char hwid[2 * crypto::SHA256_DIGEST_SIZE + 1] = {};
+    bool hwid_ready = false;
+};
+
+PureCState& state() {
+    static PureCState instance;
+    return instance;
+}
+
+// Only lc_validate_license() builds a manager, on its first call
+LicenseManager& json_manager() {
+    static LicenseManager manager(HMACValidator::from_prepared_key({embedded::KEY.inner_midstate,
+                                                                   embedded::KEY.outer_midstate}));
+    return manager;
+}
+
+// Caller holds state().mutex. The hardware probe runs once, on the first call,
+// and is the only step that allocates; afterwards this is a buffer read.
+// Throws HardwareDetectionException when the fingerprint is unavailable.
+const char* current_hwid(PureCState& s) {
+    if (!s.hwid_ready) {
+        const std::string hwid = HardwareFingerprint().get_fingerprint();
+        if (hwid.size() >= sizeof(s.hwid)) {
+            throw HardwareDetectionException("Unexpected fingerprint length");
+        }
+        std::memcpy(s.hwid, hwid.c_str(), hwid.size() + 1);
+        s.hwid_ready = true;
+    }
+    return s.hwid;
+}
+
+} // namespace
+
+extern "C" {
+
+LC_EXPORT int lc_validate_license(const char* license_json) {
+    if (license_json == nullptr) {
+        return 0;
+    }
+    try {
+        PureCState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.loaded = LoadedLicense::None;
+        if (!json_manager().load_and_validate(license_json).valid) {
+            return 0;
+        }
+        s.loaded = LoadedLicense::Json;
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+LC_EXPORT int lc_has_feature(const char* feature_name) {
+    if (feature_name == nullptr) {
+        return 0;
+    }
+    try {
+        PureCState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        switch (s.loaded) {
+        case LoadedLicense::Json:
+            return json_manager().has_feature(feature_name) ? 1 : 0;
+        case LoadedLicense::Embedded:
+            for (size_t i = 0; i < embedded::LICENSE->feature_count; ++i) {
+                if (std::strcmp(embedded::LICENSE->features[i], feature_name) == 0) {
+                    return 1;
+                }
+            }
+            return 0;
+        case LoadedLicense::None:
+            break;
+        }
+        return 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+LC_EXPORT const char* lc_get_hwid(void) {
+    try {
+        PureCState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return current_hwid(s);
+    } catch (...) {
+        return "";
+    }
+}
+
+LC_EXPORT int lc_validate_embedded(void) {
+    const embedded::EmbeddedLicense* license = embedded::LICENSE;
+    if (license == nullptr) {
+        return 0;
+    }
+    try {
+        PureCState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.loaded = LoadedLicense::None;
+        if (!embedded::verify_signature_and_expiry(embedded::KEY, *license,
+                                                   static_cast<int64_t>(std::time(nullptr)))) {
+            return 0;
+        }
+        if (std::strcmp(current_hwid(s), license->hardware_hash) != 0) {
+            return 0;
+        }
+        s.loaded = LoadedLicense::Embedded;
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,59 @@
+#include "feature_set.hpp"
+#include <algorithm>
+
+namespace license_core {
+
+namespace {
+
+size_t next_power_of_two(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+} // namespace
+
+void FeatureSet::build(const std::vector<std::string>& features) {
+    size_ = features.size();
+    const size_t slot_count = next_power_of_two(2 * size_ + 1);
+    const size_t filter_bits = next_power_of_two(std::max<size_t>(64, 8 * size_));
+    slots_.assign(slot_count, Slot{});
+    filter_.assign(filter_bits / 64, 0);
+    slot_mask_ = slot_count - 1;
+    filter_mask_ = filter_bits - 1;
+
+    for (const std::string& feature : features) {
+        const uint64_t hash = feature_hash(feature);
+        const size_t bit = (hash >> FILTER_SHIFT) & filter_mask_;
+        filter_[bit / 64] |= uint64_t(1) << (bit % 64);
+
+        size_t i = hash & slot_mask_;
+        while (slots_[i].name != nullptr) {
+            i = (i + 1) & slot_mask_;
+        }
+        slots_[i] = Slot{hash, &feature};
+    }
+}
+
+bool FeatureSet::contains(std::string_view name, uint64_t hash) const noexcept {
+    if (size_ == 0) {
+        return false;
+    }
+    const size_t bit = (hash >> FILTER_SHIFT) & filter_mask_;
+    if ((filter_[bit / 64] & (uint64_t(1) << (bit % 64))) == 0) {
+        return false;
+    }
+    for (size_t i = hash & slot_mask_;; i = (i + 1) & slot_mask_) {
+        const Slot& slot = slots_[i];
+        if (slot.name == nullptr) {
+            return false;
+        }
+        if (slot.hash == hash && *slot.name == name) {
+            return true;
+        }
+    }
+}
+
+} // namespace license_core
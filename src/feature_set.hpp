@@ -0,0 +1,47 @@
+#pragma once
+
+#include "license_core/feature_name.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace license_core {
+
+// A license's features compiled for lookup: an open-addressing table of
+// (hash, name) at most half full, fronted by a dense bitset with about eight
+// bits per feature. A feature the license lacks is usually rejected by the
+// hash and one bit test; a present one costs a probe and one comparison.
+class FeatureSet {
+public:
+    // Rebuild for features, reusing storage so a steady-state rebuild does
+    // not allocate. The set points into features, which must not change
+    // while it is in use.
+    void build(const std::vector<std::string>& features);
+
+    bool contains(std::string_view name) const noexcept {
+        return contains(name, feature_hash(name));
+    }
+    // hash is feature_hash(name)
+    bool contains(std::string_view name, uint64_t hash) const noexcept;
+
+    size_t size() const noexcept { return size_; }
+
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        const std::string* name = nullptr; // null when empty
+    };
+
+    // The bitset uses the top bits, the table the bottom ones
+    static constexpr unsigned FILTER_SHIFT = 40;
+
+    std::vector<Slot> slots_;
+    std::vector<uint64_t> filter_;
+    size_t slot_mask_ = 0;
+    size_t filter_mask_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace license_core
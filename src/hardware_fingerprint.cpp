@@ -1,6 +1,6 @@
 #include "license_core/hardware_fingerprint.hpp"
-#include <openssl/sha.h>
-#include <openssl/rand.h>
+#include "crypto/backend.hpp"
+#include "simd/hex.hpp"
 #include <sstream>
 #include <iomanip>
 #include <chrono>
@@ -39,42 +39,42 @@ HardwareFingerprint::HardwareFingerprint(const HardwareConfig& config)
 }
 
 std::string HardwareFingerprint::get_fingerprint() const {
+    std::string fingerprint;
+    get_fingerprint(fingerprint);
+    return fingerprint;
+}
+
+void HardwareFingerprint::get_fingerprint(std::string& out) const {
     if (!config_.enable_caching) {
-        update_cache_stats(false);
-        return compute_hash();
+        // Nothing cached, but the miss count is still shared state
+        if (config_.thread_safe_cache) {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            update_cache_stats(false);
+        } else {
+            update_cache_stats(false);
+        }
+        out = compute_hash();
+        return;
     }
     
+    std::unique_lock<std::mutex> lock(cache_mutex_, std::defer_lock);
     if (config_.thread_safe_cache) {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        
-        auto now = std::chrono::steady_clock::now();
-        
-        if (cached_fingerprint_.has_value() && !is_cache_expired()) {
-            update_cache_stats(true);
-            return cached_fingerprint_.value();
-        }
-        
-        std::string result = compute_hash();
-        cached_fingerprint_ = result;
-        cache_time_ = now;
-        cache_stats_.last_update = now;
-        update_cache_stats(false);
-        return result;
-    } else {
-        auto now = std::chrono::steady_clock::now();
-        
-        if (cached_fingerprint_.has_value() && !is_cache_expired()) {
-            update_cache_stats(true);
-            return cached_fingerprint_.value();
-        }
-        
-        std::string result = compute_hash();
-        cached_fingerprint_ = result;
-        cache_time_ = now;
-        cache_stats_.last_update = now;
-        update_cache_stats(false);
-        return result;
+        lock.lock();
     }
+    
+    auto now = std::chrono::steady_clock::now();
+    
+    if (cached_fingerprint_.has_value() && !is_cache_expired()) {
+        update_cache_stats(true);
+        out.assign(*cached_fingerprint_);
+        return;
+    }
+    
+    cached_fingerprint_ = compute_hash();
+    cache_time_ = now;
+    cache_stats_.last_update = now;
+    update_cache_stats(false);
+    out.assign(*cached_fingerprint_);
 }
 
 std::string HardwareFingerprint::get_fingerprint_safe() const noexcept {
@@ -308,18 +308,8 @@ std::string HardwareFingerprint::compute_hash() const {
     }
     
     try {
-        unsigned char hash[SHA256_DIGEST_LENGTH];
-        if (SHA256(reinterpret_cast<const unsigned char*>(data.c_str()), data.length(), hash) == nullptr) {
-            throw CryptographicException("SHA256 hash computation failed");
-        }
-        
-        std::stringstream ss;
-        ss << std::hex << std::setfill('0');
-        for (int i = 0; i < SHA256_DIGEST_LENGTH; ++i) {
-            ss << std::setw(2) << static_cast<unsigned int>(hash[i]);
-        }
-        
-        return ss.str();
+        auto hash = crypto::sha256(data.data(), data.length());
+        return simd::hex_encode(hash.data(), hash.size());
     } catch (const std::exception& e) {
         throw CryptographicException("Hash computation error: " + std::string(e.what()));
     }
@@ -350,35 +340,30 @@ std::string HardwareFingerprint::generate_secure_fallback(const std::string& pre
         }
         
         unsigned char random_bytes[16];
-        if (RAND_bytes(random_bytes, sizeof(random_bytes)) == 1) {
-            for (size_t i = 0; i < sizeof(random_bytes); ++i) {
-                fallback_data << std::hex << std::setfill('0') << std::setw(2) 
-                             << static_cast<unsigned int>(random_bytes[i]);
-            }
-        } else {
+        bool have_random = true;
+        try {
+            crypto::random_bytes(random_bytes, sizeof(random_bytes));
+        } catch (const CryptographicException&) {
+            have_random = false;
+        }
+        
+        if (!have_random) {
             std::random_device rd;
             std::mt19937 gen(rd());
             std::uniform_int_distribution<> dis(0, 255);
-            for (int i = 0; i < 16; ++i) {
-                fallback_data << std::hex << std::setfill('0') << std::setw(2) << dis(gen);
+            for (size_t i = 0; i < sizeof(random_bytes); ++i) {
+                random_bytes[i] = static_cast<unsigned char>(dis(gen));
             }
         }
         
-        std::string combined_data = fallback_data.str();
-        unsigned char hash[SHA256_DIGEST_LENGTH];
-        if (SHA256(reinterpret_cast<const unsigned char*>(combined_data.c_str()), 
-                   combined_data.length(), hash) == nullptr) {
-            throw CryptographicException("SHA256 fallback hash failed");
-        }
+        char random_hex[sizeof(random_bytes) * 2];
+        simd::hex_encode(random_bytes, sizeof(random_bytes), random_hex);
+        fallback_data.write(random_hex, sizeof(random_hex));
         
-        std::stringstream result;
-        result << prefix << "-";
-        for (int i = 0; i < 6; ++i) {
-            result << std::hex << std::setfill('0') << std::setw(2) 
-                   << static_cast<unsigned int>(hash[i]);
-        }
+        std::string combined_data = fallback_data.str();
+        auto hash = crypto::sha256(combined_data.data(), combined_data.length());
         
-        return result.str();
+        return prefix + "-" + simd::hex_encode(hash.data(), 6);
         
     } catch (const std::exception& e) {
         return prefix + "-fallback-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
@@ -458,12 +443,7 @@ std::string HardwareFingerprint::get_mac_address_impl() const {
         std::string mac_address;
         for (IP_ADAPTER_ADDRESSES* adapter = adapter_addresses; adapter; adapter = adapter->Next) {
             if (adapter->PhysicalAddressLength == 6) {
-                std::stringstream ss;
-                ss << std::hex << std::setfill('0');
-                for (DWORD i = 0; i < adapter->PhysicalAddressLength; ++i) {
-                    ss << std::setw(2) << static_cast<unsigned int>(adapter->PhysicalAddress[i]);
-                }
-                mac_address = ss.str();
+                mac_address = simd::hex_encode(adapter->PhysicalAddress, adapter->PhysicalAddressLength);
                 break;
             }
         }
@@ -537,12 +517,7 @@ std::string HardwareFingerprint::get_mac_address_impl() const {
                     std::string if_name(sdl->sdl_data, sdl->sdl_nlen);
                     if (if_name.find("en") == 0 || if_name.find("eth") == 0) {
                         unsigned char* ptr = (unsigned char*)(sdl->sdl_data + sdl->sdl_nlen);
-                        std::stringstream ss;
-                        ss << std::hex << std::setfill('0');
-                        for (int i = 0; i < 6; ++i) {
-                            ss << std::setw(2) << static_cast<unsigned int>(ptr[i]);
-                        }
-                        mac_address = ss.str();
+                        mac_address = simd::hex_encode(ptr, 6);
                         break;
                     }
                 }
@@ -630,12 +605,7 @@ std::string HardwareFingerprint::get_mac_address_impl() const {
             if (ifa->ifa_addr && ifa->ifa_addr->sa_family == AF_PACKET) {
                 struct sockaddr_ll* s = (struct sockaddr_ll*)ifa->ifa_addr;
                 if (s->sll_halen == 6) {
-                    std::stringstream ss;
-                    ss << std::hex << std::setfill('0');
-                    for (int i = 0; i < 6; ++i) {
-                        ss << std::setw(2) << static_cast<unsigned int>(s->sll_addr[i]);
-                    }
-                    mac_address = ss.str();
+                    mac_address = simd::hex_encode(s->sll_addr, 6);
                     break;
                 }
             }
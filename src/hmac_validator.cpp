@@ -1,29 +1,136 @@
 #include "license_core/hmac_validator.hpp"
 #include "license_core/license_manager.hpp"
 #include "json/simple_json.hpp"
-#include <openssl/hmac.h>
-#include <openssl/sha.h>
-#include <openssl/evp.h>
-#include <iomanip>
-#include <sstream>
+#include "crypto/hmac_sha256.hpp"
+#include "crypto/backend.hpp"
+#include "simd/hex.hpp"
 #include <algorithm>
 #include <stdexcept>
-#include <cctype>
+#include <new>
+#include <type_traits>
 
 namespace license_core {
 
-HMACValidator::HMACValidator(const std::string& secret_key) 
-    : secret_key_(secret_key) {
-    if (secret_key_.empty()) {
+namespace {
+
+crypto::HmacSha256Stream& stream_state(unsigned char* storage) noexcept {
+    return *std::launder(reinterpret_cast<crypto::HmacSha256Stream*>(storage));
+}
+
+void validate_secret(const std::string& secret_key) {
+    if (secret_key.empty()) {
         throw CryptographicException("Secret key cannot be empty");
     }
     
     // Validate key strength (minimum 16 bytes recommended)
-    if (secret_key_.length() < 16) {
+    if (secret_key.length() < 16) {
         throw CryptographicException("Secret key too short (minimum 16 characters required)");
     }
 }
 
+std::shared_ptr<const crypto::HmacSha256Key> make_key(const std::string& secret_key) {
+    validate_secret(secret_key);
+    return std::make_shared<const crypto::HmacSha256Key>(secret_key);
+}
+
+// One-shot MAC resumed from the key's midstates. The state lives on the
+// stack, so unlike cloning a backend context it never touches the heap.
+crypto::Sha256Digest mac_of(const crypto::HmacSha256Key& key, std::string_view data) noexcept {
+    crypto::HmacSha256Stream stream(key);
+    stream.update(data.data(), data.size());
+    return stream.final();
+}
+
+bool verify_with(const crypto::HmacSha256Key& key, std::string_view data,
+                 const HMACValidator::Digest& signature) {
+    if (data.empty()) {
+        throw CryptographicException("Cannot verify empty data");
+    }
+    
+    // Constant-time comparison to prevent timing attacks
+    return crypto::digests_equal(mac_of(key, data), signature);
+}
+
+template<typename Segments>
+HMACValidator::Stream& feed_segments(HMACValidator::Stream& stream, const Segments& segments) {
+    for (std::string_view segment : segments) {
+        stream.update(segment);
+    }
+    return stream;
+}
+
+} // namespace
+
+// Stream copies its state bytewise, so the engine must be trivially copyable
+static_assert(std::is_trivially_copyable<crypto::HmacSha256Stream>::value,
+              "HMAC stream state must be trivially copyable");
+static_assert(std::is_trivially_destructible<crypto::HmacSha256Stream>::value,
+              "HMAC stream state must be trivially destructible");
+
+HMACValidator::HMACValidator(const std::string& secret_key)
+    : HMACValidator(make_key(secret_key)) {
+}
+
+HMACValidator::HMACValidator(KeyPtr key) : key_(std::move(key)) {
+    keys_.emplace(signing_kid_, key_);
+}
+
+HMACValidator::PreparedKey HMACValidator::prepare_key(const std::string& secret_key) {
+    validate_secret(secret_key);
+    
+    PreparedKey prepared;
+    crypto::hmac_sha256_midstates(secret_key, prepared.inner, prepared.outer);
+    return prepared;
+}
+
+HMACValidator HMACValidator::from_prepared_key(const PreparedKey& key) {
+    return HMACValidator(std::make_shared<const crypto::HmacSha256Key>(key.inner, key.outer));
+}
+
+void HMACValidator::add_key(const std::string& kid, const std::string& secret_key) {
+    KeyPtr key = make_key(secret_key);
+    if (kid == signing_kid_) {
+        key_ = key;
+    }
+    keys_[kid] = std::move(key);
+}
+
+bool HMACValidator::remove_key(const std::string& kid) {
+    if (kid == signing_kid_) {
+        throw CryptographicException("Cannot remove the signing key");
+    }
+    return keys_.erase(kid) > 0;
+}
+
+bool HMACValidator::has_key(const std::string& kid) const {
+    return keys_.find(kid) != keys_.end();
+}
+
+size_t HMACValidator::key_count() const {
+    return keys_.size();
+}
+
+void HMACValidator::set_signing_key(const std::string& kid) {
+    auto it = keys_.find(kid);
+    if (it == keys_.end()) {
+        throw CryptographicException("Unknown key id: " + kid);
+    }
+    key_ = it->second;
+    signing_kid_ = kid;
+}
+
+const std::string& HMACValidator::signing_key_id() const {
+    return signing_kid_;
+}
+
+const crypto::HmacSha256Key& HMACValidator::key_for(const std::string& kid) const {
+    auto it = keys_.find(kid);
+    if (it == keys_.end()) {
+        throw InvalidSignatureException("Unknown key id: " + kid);
+    }
+    return *it->second;
+}
+
 std::string HMACValidator::sign(const std::string& data) const {
     if (data.empty()) {
         throw CryptographicException("Cannot sign empty data");
@@ -45,26 +152,171 @@ bool HMACValidator::verify(const std::string& data, const std::string& signature
         throw InvalidSignatureException("Signature cannot be empty");
     }
     
+    // Malformed hex can never match a digest
+    Digest expected;
+    if (!decode_signature(signature, expected)) {
+        return false;
+    }
+    
+    return verify_raw(data, expected);
+}
+
+bool HMACValidator::verify(const std::string& data, const std::string& signature,
+                           const std::string& kid) const {
+    const crypto::HmacSha256Key& key = key_for(kid);
+    
+    if (data.empty()) {
+        throw CryptographicException("Cannot verify empty data");
+    }
+    
+    if (signature.empty()) {
+        throw InvalidSignatureException("Signature cannot be empty");
+    }
+    
+    Digest expected;
+    if (!decode_signature(signature, expected)) {
+        return false;
+    }
+    
+    return verify_with(key, data, expected);
+}
+
+HMACValidator::Digest HMACValidator::sign_raw(std::string_view data) const {
+    if (data.empty()) {
+        throw CryptographicException("Cannot sign empty data");
+    }
+    
+    return mac_of(*key_, data);
+}
+
+bool HMACValidator::verify_raw(std::string_view data, const Digest& signature) const {
+    return verify_with(*key_, data, signature);
+}
+
+bool HMACValidator::verify_raw(std::string_view data, const Digest& signature,
+                               const std::string& kid) const {
+    return verify_with(key_for(kid), data, signature);
+}
+
+HMACValidator::Stream& HMACValidator::Stream::update(std::string_view data) {
+    return update(data.data(), data.size());
+}
+
+HMACValidator::Stream& HMACValidator::Stream::update(const void* data, size_t length) {
+    if (finished_) {
+        throw CryptographicException("HMAC stream already finished");
+    }
+    
+    stream_state(state_).update(data, length);
+    length_ += length;
+    return *this;
+}
+
+HMACValidator::Digest HMACValidator::Stream::final() {
+    if (finished_) {
+        throw CryptographicException("HMAC stream already finished");
+    }
+    if (length_ == 0) {
+        throw CryptographicException("Cannot sign empty data");
+    }
+    
+    finished_ = true;
+    return stream_state(state_).final();
+}
+
+bool HMACValidator::Stream::verify(const Digest& signature) {
+    return crypto::digests_equal(final(), signature);
+}
+
+HMACValidator::Stream HMACValidator::begin_stream() const {
+    return start_stream(*key_);
+}
+
+HMACValidator::Stream HMACValidator::begin_stream(const std::string& kid) const {
+    return start_stream(key_for(kid));
+}
+
+HMACValidator::Stream HMACValidator::start_stream(const crypto::HmacSha256Key& key) {
+    static_assert(sizeof(crypto::HmacSha256Stream) <= Stream::STATE_SIZE,
+                  "HMAC stream state does not fit inline storage");
+    static_assert(alignof(crypto::HmacSha256Stream) <= 8,
+                  "HMAC stream state is over-aligned");
+    
+    Stream stream;
+    new (stream.state_) crypto::HmacSha256Stream(key);
+    return stream;
+}
+
+HMACValidator::Digest HMACValidator::sign_segments(std::initializer_list<std::string_view> segments) const {
+    Stream stream = begin_stream();
+    return feed_segments(stream, segments).final();
+}
+
+HMACValidator::Digest HMACValidator::sign_segments(const std::vector<std::string_view>& segments) const {
+    Stream stream = begin_stream();
+    return feed_segments(stream, segments).final();
+}
+
+bool HMACValidator::verify_segments(std::initializer_list<std::string_view> segments,
+                                    const Digest& signature) const {
+    Stream stream = begin_stream();
+    return feed_segments(stream, segments).verify(signature);
+}
+
+bool HMACValidator::verify_segments(const std::vector<std::string_view>& segments,
+                                    const Digest& signature) const {
+    Stream stream = begin_stream();
+    return feed_segments(stream, segments).verify(signature);
+}
+
+std::vector<bool> HMACValidator::verify_batch(const BatchItem* items, size_t count) const {
+    // Decoded signatures and per-item jobs live on the stack, one chunk at a time
+    constexpr size_t CHUNK = 256;
+    Digest expected[CHUNK];
+    crypto::HmacBatchJob jobs[CHUNK];
+    bool chunk_results[CHUNK];
+    
+    std::vector<bool> results(count, false);
+    
     try {
-        auto computed_signature = compute_hmac_sha256(data);
-        
-        // Constant-time comparison to prevent timing attacks
-        if (computed_signature.length() != signature.length()) {
-            return false;
-        }
-        
-        int result = 0;
-        for (size_t i = 0; i < computed_signature.length(); ++i) {
-            result |= computed_signature[i] ^ signature[i];
+        for (size_t base = 0; base < count; base += CHUNK) {
+            size_t n = std::min(CHUNK, count - base);
+            
+            for (size_t i = 0; i < n; ++i) {
+                const BatchItem& item = items[base + i];
+                jobs[i].data = reinterpret_cast<const uint8_t*>(item.data.data());
+                jobs[i].length = item.data.size();
+                jobs[i].expected = (!item.data.empty() && decode_signature(item.signature, expected[i]))
+                                       ? &expected[i] : nullptr;
+            }
+            
+            key_->verify_batch(jobs, n, chunk_results);
+            
+            for (size_t i = 0; i < n; ++i) {
+                results[base + i] = chunk_results[i];
+            }
         }
-        
-        return result == 0;
-        
-    } catch (const CryptographicException&) {
-        throw;
     } catch (const std::exception& e) {
-        throw CryptographicException("HMAC verification failed: " + std::string(e.what()));
+        throw CryptographicException("HMAC batch verification failed: " + std::string(e.what()));
+    }
+    
+    return results;
+}
+
+std::vector<bool> HMACValidator::verify_batch(const std::vector<BatchItem>& items) const {
+    return verify_batch(items.data(), items.size());
+}
+
+const char* HMACValidator::crypto_backend() noexcept {
+    return crypto::backend_name();
+}
+
+bool HMACValidator::decode_signature(std::string_view hex, Digest& out) noexcept {
+    if (hex.size() != DIGEST_SIZE * 2) {
+        return false;
     }
+    
+    return simd::hex_decode(hex.data(), DIGEST_SIZE, out.data());
 }
 
 void HMACValidator::verify_or_throw(const std::string& data, const std::string& signature) const {
@@ -80,12 +332,15 @@ std::string HMACValidator::sign_json(const std::string& json_without_signature)
     
     try {
         // Validate that input is valid JSON
-        auto parsed = json::SimpleJson::parse(json_without_signature);
-        
-        // Re-stringify to ensure consistent formatting
-        std::string normalized_json = json::SimpleJson::stringify(parsed);
+        auto document = json::SimpleJson::parse_view(json_without_signature);
         
-        return sign(normalized_json);
+        // Sign the consistent formatting stringify() would produce, streamed
+        Stream stream = begin_stream();
+        json::SimpleJson::write_canonical(document, [&stream](const char* data, size_t length) {
+            stream.update(data, length);
+        });
+        Digest digest = stream.final();
+        return simd::hex_encode(digest.data(), digest.size());
         
     } catch (const std::exception& e) {
         throw JsonParsingException("JSON signing failed: " + std::string(e.what()));
@@ -99,21 +354,33 @@ bool HMACValidator::verify_json(const std::string& json_with_signature) const {
     
     try {
         // Parse JSON
-        auto parsed = json::SimpleJson::parse(json_with_signature);
+        auto document = json::SimpleJson::parse_view(json_with_signature);
         
         // Check if signature field exists
-        if (!json::SimpleJson::has_key(parsed, "hmac_signature")) {
+        if (!document.has_key("hmac_signature")) {
             throw JsonParsingException("JSON missing hmac_signature field");
         }
         
         // Extract signature
-        std::string signature = json::SimpleJson::get_string(parsed, "hmac_signature");
+        std::string signature = document.get_string("hmac_signature");
         
-        // Remove signature field for verification
-        parsed.erase("hmac_signature");
-        std::string data_to_verify = json::SimpleJson::stringify(parsed);
+        // Key id is part of the signed data; absent means the default key
+        std::string kid = document.get_string("kid");
         
-        return verify(data_to_verify, signature);
+        Stream stream = begin_stream(kid);
+        if (signature.empty()) {
+            throw InvalidSignatureException("Signature cannot be empty");
+        }
+        Digest expected;
+        if (!decode_signature(signature, expected)) {
+            return false;
+        }
+        
+        // Hash the canonical form without the signature field, never materializing it
+        json::SimpleJson::write_canonical(document, "hmac_signature", [&stream](const char* data, size_t length) {
+            stream.update(data, length);
+        });
+        return stream.verify(expected);
         
     } catch (const LicenseException&) {
         throw;
@@ -128,26 +395,110 @@ void HMACValidator::verify_json_or_throw(const std::string& json_with_signature)
     }
 }
 
-std::string HMACValidator::compute_hmac_sha256(const std::string& data) const {
+namespace {
+
+struct EnvelopeParts {
+    HMACValidator::Digest signature;
+    std::string_view kid;
+    std::string_view payload;
+};
+
+// Header checks only, no hashing; returns the error message or nullptr
+const char* split_envelope(std::string_view envelope, EnvelopeParts& parts) noexcept {
+    constexpr size_t SIGNATURE_END = HMACValidator::ENVELOPE_MAGIC.size() + 2 * HMACValidator::DIGEST_SIZE;
+    if (!HMACValidator::is_envelope(envelope) || envelope.size() <= SIGNATURE_END) {
+        return "Malformed envelope header";
+    }
+    
+    if (!HMACValidator::decode_signature(envelope.substr(HMACValidator::ENVELOPE_MAGIC.size(),
+                                                         2 * HMACValidator::DIGEST_SIZE), parts.signature)) {
+        return "Malformed envelope signature";
+    }
+    
+    // Either "\n" right after the signature, or " kid\n"
+    size_t newline = envelope.find('\n', SIGNATURE_END);
+    if (newline == std::string_view::npos ||
+        (newline != SIGNATURE_END && (envelope[SIGNATURE_END] != ' ' || newline == SIGNATURE_END + 1))) {
+        return "Malformed envelope header";
+    }
+    parts.kid = newline == SIGNATURE_END ? std::string_view()
+                                         : envelope.substr(SIGNATURE_END + 1, newline - SIGNATURE_END - 1);
+    
+    parts.payload = envelope.substr(newline + 1);
+    if (parts.payload.empty()) {
+        return "Envelope payload is empty";
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool HMACValidator::is_envelope(std::string_view data) noexcept {
+    return data.substr(0, ENVELOPE_MAGIC.size()) == ENVELOPE_MAGIC;
+}
+
+std::string HMACValidator::seal_envelope(std::string_view payload) const {
+    if (signing_kid_.find_first_of(" \n") != std::string::npos) {
+        throw CryptographicException("Key id cannot be used in an envelope header: " + signing_kid_);
+    }
+    Digest digest = sign_raw(payload);
+    
+    std::string envelope;
+    envelope.reserve(ENVELOPE_MAGIC.size() + 2 * DIGEST_SIZE + signing_kid_.size() + 2 + payload.size());
+    envelope.append(ENVELOPE_MAGIC);
+    envelope.resize(envelope.size() + 2 * DIGEST_SIZE);
+    simd::hex_encode(digest.data(), digest.size(), &envelope[ENVELOPE_MAGIC.size()]);
+    if (!signing_kid_.empty()) {
+        envelope += ' ';
+        envelope += signing_kid_;
+    }
+    envelope += '\n';
+    envelope.append(payload);
+    return envelope;
+}
+
+std::string_view HMACValidator::open_envelope(std::string_view envelope, std::string& kid) const {
+    std::string_view payload;
+    std::string_view header_kid;
+    if (const char* error = try_open_envelope(envelope, payload, header_kid)) {
+        throw InvalidSignatureException(error);
+    }
+    kid.assign(header_kid);
+    return payload;
+}
+
+const char* HMACValidator::try_open_envelope(std::string_view envelope, std::string_view& payload,
+                                             std::string_view& kid) const noexcept {
+    EnvelopeParts parts;
+    if (const char* error = split_envelope(envelope, parts)) {
+        return error;
+    }
     try {
-        unsigned char result[EVP_MAX_MD_SIZE];
-        unsigned int result_len = 0;
-        
-        unsigned char* mac = HMAC(
-            EVP_sha256(),
-            secret_key_.c_str(),
-            static_cast<int>(secret_key_.length()),
-            reinterpret_cast<const unsigned char*>(data.c_str()),
-            data.length(),
-            result,
-            &result_len
-        );
-        
-        if (mac == nullptr) {
-            throw CryptographicException("HMAC computation failed");
+        auto it = keys_.find(std::string(parts.kid));
+        if (it == keys_.end()) {
+            return "Unknown envelope key id";
         }
-        
-        return to_hex(std::vector<uint8_t>(result, result + result_len));
+        if (!verify_with(*it->second, parts.payload, parts.signature)) {
+            return "Envelope HMAC verification failed";
+        }
+    } catch (...) {
+        return "Envelope HMAC verification failed";
+    }
+    payload = parts.payload;
+    kid = parts.kid;
+    return nullptr;
+}
+
+bool HMACValidator::verify_envelope(std::string_view envelope) const noexcept {
+    std::string_view payload;
+    std::string_view kid;
+    return try_open_envelope(envelope, payload, kid) == nullptr;
+}
+
+std::string HMACValidator::compute_hmac_sha256(const std::string& data) const {
+    try {
+        auto digest = mac_of(*key_, data);
+        return simd::hex_encode(digest.data(), digest.size());
         
     } catch (const std::exception& e) {
         throw CryptographicException("HMAC-SHA256 computation error: " + std::string(e.what()));
@@ -155,48 +506,19 @@ std::string HMACValidator::compute_hmac_sha256(const std::string& data) const {
 }
 
 std::string HMACValidator::to_hex(const std::vector<uint8_t>& bytes) const {
-    try {
-        std::stringstream ss;
-        ss << std::hex << std::setfill('0');
-        for (uint8_t byte : bytes) {
-            ss << std::setw(2) << static_cast<unsigned int>(byte);
-        }
-        return ss.str();
-    } catch (const std::exception& e) {
-        throw CryptographicException("Hex encoding failed: " + std::string(e.what()));
-    }
+    return simd::hex_encode(bytes.data(), bytes.size());
 }
 
 std::vector<uint8_t> HMACValidator::from_hex(const std::string& hex) const {
-    try {
-        if (hex.length() % 2 != 0) {
-            throw CryptographicException("Invalid hex string length (must be even)");
-        }
-        
-        std::vector<uint8_t> bytes;
-        bytes.reserve(hex.length() / 2);
-        
-        for (size_t i = 0; i < hex.length(); i += 2) {
-            std::string byte_string = hex.substr(i, 2);
-            
-            // Validate hex characters
-            for (char c : byte_string) {
-                if (!std::isxdigit(static_cast<unsigned char>(c))) {
-                    throw CryptographicException("Invalid hex character: " + std::string(1, c));
-                }
-            }
-            
-            uint8_t byte = static_cast<uint8_t>(std::stoul(byte_string, nullptr, 16));
-            bytes.push_back(byte);
-        }
-        
-        return bytes;
-        
-    } catch (const CryptographicException&) {
-        throw;
-    } catch (const std::exception& e) {
-        throw CryptographicException("Hex decoding failed: " + std::string(e.what()));
+    if (hex.length() % 2 != 0) {
+        throw CryptographicException("Invalid hex string length (must be even)");
+    }
+    
+    std::vector<uint8_t> bytes(hex.length() / 2);
+    if (!simd::hex_decode(hex.data(), bytes.size(), bytes.data())) {
+        throw CryptographicException("Invalid hex character");
     }
+    return bytes;
 }
 
 bool HMACValidator::validate_license(const LicenseInfo& license_info, const std::string& hardware_id) const {
@@ -0,0 +1,181 @@
+#include "iso8601.hpp"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace license_core {
+namespace iso8601 {
+
+namespace {
+
+std::tm gmtime_safe(std::time_t time_value) {
+    std::tm tm{};
+#ifdef _WIN32
+    if (gmtime_s(&tm, &time_value) != 0) {
+        throw std::runtime_error("Failed to convert time");
+    }
+#else
+    if (gmtime_r(&time_value, &tm) == nullptr) {
+        throw std::runtime_error("Failed to convert time");
+    }
+#endif
+    return tm;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date; days past the end of
+// the month roll over exactly like timegm() normalization
+int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+// Inverse of days_from_civil
+void civil_from_days(int64_t days, int64_t& y, unsigned& m, unsigned& d) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+void write_digits(char* out, unsigned value, size_t count) {
+    for (size_t i = count; i > 0; --i) {
+        out[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+bool read_digits(std::string_view s, size_t pos, size_t count, int& out) {
+    int value = 0;
+    for (size_t i = 0; i < count; ++i) {
+        char c = s[pos + i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    out = value;
+    return true;
+}
+
+// Fixed-width fields of YYYY-MM-DD or YYYY-MM-DDTHH:MM:SS, exactly s, each
+// in range (second up to max_second); false on anything else
+bool read_fields(std::string_view s, int max_second, int64_t& seconds) {
+    if (s.size() != 10 && s.size() != 19) {
+        return false;
+    }
+
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    if (!read_digits(s, 0, 4, year) || s[4] != '-' || !read_digits(s, 5, 2, month) ||
+        s[7] != '-' || !read_digits(s, 8, 2, day)) {
+        return false;
+    }
+    if (s.size() == 19 && (s[10] != 'T' || !read_digits(s, 11, 2, hour) || s[13] != ':' ||
+                           !read_digits(s, 14, 2, minute) || s[16] != ':' || !read_digits(s, 17, 2, second))) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > max_second) {
+        return false;
+    }
+
+    seconds = days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400 +
+              hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+std::string_view trim_trailing_space(std::string_view s) {
+    while (!s.empty() && is_space(s.back())) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+} // namespace
+
+std::chrono::system_clock::time_point parse(std::string_view date_str) {
+    if (date_str.empty()) {
+        throw std::invalid_argument("Date string cannot be empty");
+    }
+
+    // Canonical layouts first: exact length, optional Z, no leap second
+    int64_t seconds;
+    const bool has_z = date_str.size() == 20 && date_str[19] == 'Z';
+    if (read_fields(has_z ? date_str.substr(0, 19) : date_str, 59, seconds)) {
+        return std::chrono::system_clock::from_time_t(static_cast<std::time_t>(seconds));
+    }
+
+    // Otherwise the same fixed-width fields, followed by whitespace and, after
+    // a time, a Z with whitespace either side; a leap second rolls over
+    std::string_view body = trim_trailing_space(date_str);
+    if (body.size() > 19 && body.back() == 'Z') {
+        body = trim_trailing_space(body.substr(0, body.size() - 1));
+        if (body.size() != 19) {
+            throw std::invalid_argument("Invalid date format: " + std::string(date_str));
+        }
+    }
+    if (!read_fields(body, 60, seconds)) {
+        throw std::invalid_argument("Invalid date format: " + std::string(date_str));
+    }
+    return std::chrono::system_clock::from_time_t(static_cast<std::time_t>(seconds));
+}
+
+std::string format(const std::chrono::system_clock::time_point& time_point) {
+    auto time_t = std::chrono::system_clock::to_time_t(time_point);
+    const std::tm tm = gmtime_safe(time_t);
+
+    std::ostringstream ss;
+    ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+    return ss.str();
+}
+
+size_t format_to(const std::chrono::system_clock::time_point& time_point, char (&out)[FORMAT_BUFFER_SIZE]) {
+    const int64_t seconds = static_cast<int64_t>(std::chrono::system_clock::to_time_t(time_point));
+    int64_t days = seconds / 86400;
+    int64_t second_of_day = seconds % 86400;
+    if (second_of_day < 0) {
+        second_of_day += 86400;
+        --days;
+    }
+
+    int64_t year;
+    unsigned month, day;
+    civil_from_days(days, year, month, day);
+    if (year < 0 || year > 9999) {
+        // Outside the fixed-width layout; let put_time decide
+        const std::string text = format(time_point);
+        const size_t length = std::min(text.size(), FORMAT_BUFFER_SIZE);
+        text.copy(out, length);
+        return length;
+    }
+
+    write_digits(out, static_cast<unsigned>(year), 4);
+    out[4] = '-';
+    write_digits(out + 5, month, 2);
+    out[7] = '-';
+    write_digits(out + 8, day, 2);
+    out[10] = 'T';
+    write_digits(out + 11, static_cast<unsigned>(second_of_day / 3600), 2);
+    out[13] = ':';
+    write_digits(out + 14, static_cast<unsigned>(second_of_day / 60 % 60), 2);
+    out[16] = ':';
+    write_digits(out + 17, static_cast<unsigned>(second_of_day % 60), 2);
+    out[19] = 'Z';
+    return 20;
+}
+
+} // namespace iso8601
+} // namespace license_core
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// UTC timestamps as used in license files
+namespace license_core {
+namespace iso8601 {
+
+// Accepts YYYY-MM-DDTHH:MM:SS with an optional trailing Z, or YYYY-MM-DD,
+// every field at its full width, then optional whitespace. Throws
+// std::invalid_argument on anything else.
+std::chrono::system_clock::time_point parse(std::string_view date_str);
+
+// YYYY-MM-DDTHH:MM:SSZ
+std::string format(const std::chrono::system_clock::time_point& time_point);
+
+// Room for format_to(); years past 9999 take more digits
+constexpr size_t FORMAT_BUFFER_SIZE = 32;
+
+// Same text as format() written into out without allocating; returns its length
+size_t format_to(const std::chrono::system_clock::time_point& time_point, char (&out)[FORMAT_BUFFER_SIZE]);
+
+} // namespace iso8601
+} // namespace license_core
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "simple_json.hpp"
+#include "simd/json_escape.hpp"
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+// Chunked writer for the canonical signed form (SimpleJson::stringify layout),
+// shared by SimpleJson::write_canonical and the binary license encoding
+namespace license_core {
+namespace json {
+namespace detail {
+
+// Second character of the two-character escape stringify() emits, 0 if none
+struct EscapeTable {
+    char codes[256];
+    constexpr EscapeTable() : codes() {
+        codes[static_cast<unsigned char>('"')] = '"';
+        codes[static_cast<unsigned char>('\\')] = '\\';
+        codes[static_cast<unsigned char>('\b')] = 'b';
+        codes[static_cast<unsigned char>('\f')] = 'f';
+        codes[static_cast<unsigned char>('\n')] = 'n';
+        codes[static_cast<unsigned char>('\r')] = 'r';
+        codes[static_cast<unsigned char>('\t')] = 't';
+    }
+    char operator[](char c) const { return codes[static_cast<unsigned char>(c)]; }
+};
+
+inline constexpr EscapeTable ESCAPES;
+
+// Escapes unescape_into() resolves; re-escaping their result gives back the same two characters
+inline bool is_known_escape(char c) {
+    return c == '"' || c == '\\' || c == 'b' || c == 'f' || c == 'n' || c == 'r' || c == 't';
+}
+
+// Batches the many small pieces of the canonical form into sink-sized chunks
+class CanonicalWriter {
+public:
+    using Sink = void (*)(void* context, const char* data, size_t length);
+    
+    CanonicalWriter(Sink sink, void* context) : sink_(sink), context_(context) {}
+    
+    void put(std::string_view s) {
+        if (s.size() > sizeof(buffer_) - size_) {
+            flush();
+            if (s.size() >= sizeof(buffer_)) {
+                sink_(context_, s.data(), s.size());
+                return;
+            }
+        }
+        std::memcpy(buffer_ + size_, s.data(), s.size());
+        size_ += s.size();
+    }
+    
+    void put_escape(char code) {
+        const char pair[2] = {'\\', code};
+        put(std::string_view(pair, 2));
+    }
+    
+    // escape_json_string(s)
+    void put_escaped(std::string_view s) {
+        for (;;) {
+            size_t run = simd::find_json_escape(s.data(), s.size());
+            put(s.substr(0, run));
+            if (run == s.size()) {
+                return;
+            }
+            put_escape(ESCAPES[s[run]]);
+            s.remove_prefix(run + 1);
+        }
+    }
+    
+    // escape_json_string(unescape(raw)) without the intermediate copy: a known
+    // escape comes back unchanged, any other backslash was kept literally
+    void put_reescaped(std::string_view raw) {
+        size_t run = 0;
+        for (size_t i = 0; i < raw.size(); ++i) {
+            if (raw[i] == '\\' && i + 1 < raw.size() && is_known_escape(raw[i + 1])) {
+                ++i;
+                continue;
+            }
+            char code = ESCAPES[raw[i]];
+            if (code != 0) {
+                put(raw.substr(run, i - run));
+                put_escape(code);
+                run = i + 1;
+            }
+        }
+        put(raw.substr(run));
+    }
+    
+    void put_string(const JsonStringView& value) {
+        put("\"");
+        if (value.escaped) {
+            put_reescaped(value.raw);
+        } else {
+            put_escaped(value.raw);
+        }
+        put("\"");
+    }
+    
+    void flush() {
+        if (size_ != 0) {
+            sink_(context_, buffer_, size_);
+            size_ = 0;
+        }
+    }
+    
+private:
+    Sink sink_;
+    void* context_;
+    char buffer_[256];
+    size_t size_ = 0;
+};
+
+} // namespace detail
+} // namespace json
+} // namespace license_core
@@ -0,0 +1,249 @@
+#include "incremental_parser.hpp"
+#include <algorithm>
+
+namespace license_core {
+namespace json {
+
+namespace {
+
+// Same set as std::isspace in the "C" locale
+inline bool is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Bytes that end an unquoted value; after it only some of them may follow
+constexpr std::string_view SCALAR_END = " \t\n\v\f\r,:\"[]{}";
+
+} // namespace
+
+void IncrementalParser::feed(std::string_view chunk) {
+    if (state_ == State::Failed) {
+        throw JsonParsingException("JSON parser used after an error without reset()");
+    }
+    try {
+        // The whole chunk is rejected before any of it is consumed
+        SafeJsonParser::validate_size(bytes_fed_ + chunk.size());
+        consume(chunk);
+        bytes_fed_ += chunk.size();
+    } catch (...) {
+        state_ = State::Failed;
+        throw;
+    }
+}
+
+void IncrementalParser::finish(JsonDocumentView& doc) {
+    if (state_ == State::Failed) {
+        throw JsonParsingException("JSON parser used after an error without reset()");
+    }
+    if (state_ != State::Done) {
+        throw JsonParsingException("Incomplete JSON object after " + std::to_string(bytes_fed_) + " bytes");
+    }
+    SimpleJson::parse_view(json_, doc);
+}
+
+void IncrementalParser::reset() noexcept {
+    json_.clear();
+    state_ = State::Start;
+    escape_pending_ = false;
+    array_empty_ = true;
+    token_length_ = 0;
+    field_count_ = 0;
+    item_count_ = 0;
+    bytes_fed_ = 0;
+}
+
+void IncrementalParser::consume(std::string_view chunk) {
+    size_t pos = 0;
+    while (pos < chunk.size()) {
+        const char c = chunk[pos];
+        if (is_space(c) && state_ != State::String && state_ != State::Scalar && state_ != State::ItemScalar) {
+            ++pos;
+            continue;
+        }
+
+        switch (state_) {
+        case State::Start:
+            if (c != '{') unexpected(chunk, pos);
+            json_ += '{';
+            state_ = State::KeyOrEnd;
+            ++pos;
+            break;
+
+        case State::KeyOrEnd:
+            if (c == '}') {
+                json_ += '}';
+                state_ = State::Done;
+                ++pos;
+                break;
+            }
+            [[fallthrough]];
+        case State::Key:
+            if (c != '"') unexpected(chunk, pos);
+            SafeJsonParser::validate_object_size(field_count_);
+            if (field_count_ != 0) json_ += ',';
+            begin_string(StringKind::Key);
+            ++pos;
+            break;
+
+        case State::Colon:
+            if (c != ':') unexpected(chunk, pos);
+            json_ += ':';
+            state_ = State::Value;
+            ++pos;
+            break;
+
+        case State::Value:
+            if (c == '"') {
+                begin_string(StringKind::Value);
+                ++pos;
+            } else if (c == '[') {
+                json_ += '[';
+                array_empty_ = true;
+                item_count_ = 0;
+                state_ = State::ItemOrEnd;
+                ++pos;
+            } else if (SCALAR_END.find(c) != std::string_view::npos) {
+                unexpected(chunk, pos);
+            } else {
+                token_length_ = 0;
+                state_ = State::Scalar; // c is its first byte
+            }
+            break;
+
+        case State::String: {
+            if (escape_pending_) {
+                escape_pending_ = false;
+                append_token(chunk.substr(pos, 1));
+                ++pos;
+                break;
+            }
+            // Whole runs up to the next quote or backslash at a time
+            size_t end = std::min(chunk.find_first_of("\"\\", pos), chunk.size());
+            append_token(chunk.substr(pos, end - pos));
+            pos = end;
+            if (pos == chunk.size()) break;
+            if (chunk[pos] == '\\') {
+                escape_pending_ = true;
+                append_token(chunk.substr(pos, 1));
+            } else {
+                end_string();
+            }
+            ++pos;
+            break;
+        }
+
+        case State::Scalar:
+        case State::ItemScalar: {
+            size_t end = std::min(chunk.find_first_of(SCALAR_END, pos), chunk.size());
+            append_token(chunk.substr(pos, end - pos));
+            pos = end;
+            if (pos == chunk.size()) break;
+            const char next = chunk[pos];
+            // The delimiter itself is left for the next state
+            if (state_ == State::Scalar && (is_space(next) || next == ',' || next == '}')) {
+                ++field_count_;
+                state_ = State::AfterValue;
+            } else if (state_ == State::ItemScalar && (is_space(next) || next == ',' || next == ']')) {
+                state_ = State::AfterItem;
+            } else {
+                unexpected(chunk, pos);
+            }
+            break;
+        }
+
+        case State::AfterValue:
+            if (c == ',') {
+                state_ = State::Key; // the comma is written with the key
+            } else if (c == '}') {
+                json_ += '}';
+                state_ = State::Done;
+            } else {
+                unexpected(chunk, pos);
+            }
+            ++pos;
+            break;
+
+        case State::ItemOrEnd:
+            if (c == ']') {
+                json_ += ']';
+                ++field_count_;
+                state_ = State::AfterValue;
+                ++pos;
+                break;
+            }
+            [[fallthrough]];
+        case State::Item:
+            if (c != '"' && SCALAR_END.find(c) != std::string_view::npos) unexpected(chunk, pos);
+            // Non-string items are kept; parse_view skips them as before
+            SafeJsonParser::validate_array_size(item_count_);
+            if (!array_empty_) json_ += ',';
+            array_empty_ = false;
+            if (c == '"') {
+                begin_string(StringKind::Item);
+                ++pos;
+            } else {
+                token_length_ = 0;
+                state_ = State::ItemScalar;
+            }
+            break;
+
+        case State::AfterItem:
+            if (c == ',') {
+                state_ = State::Item;
+            } else if (c == ']') {
+                json_ += ']';
+                ++field_count_;
+                state_ = State::AfterValue;
+            } else {
+                unexpected(chunk, pos);
+            }
+            ++pos;
+            break;
+
+        case State::Done:
+        case State::Failed:
+            unexpected(chunk, pos);
+        }
+    }
+}
+
+void IncrementalParser::begin_string(StringKind kind) {
+    json_ += '"';
+    string_kind_ = kind;
+    token_length_ = 0;
+    state_ = State::String;
+}
+
+void IncrementalParser::end_string() {
+    json_ += '"';
+    switch (string_kind_) {
+    case StringKind::Key:
+        state_ = State::Colon;
+        break;
+    case StringKind::Value:
+        ++field_count_;
+        state_ = State::AfterValue;
+        break;
+    case StringKind::Item:
+        ++item_count_;
+        state_ = State::AfterItem;
+        break;
+    }
+}
+
+void IncrementalParser::append_token(std::string_view bytes) {
+    // Checked before buffering, so an overlong string is never held
+    token_length_ += bytes.size();
+    SafeJsonParser::validate_string_length(token_length_);
+    json_.append(bytes.data(), bytes.size());
+}
+
+void IncrementalParser::unexpected(std::string_view chunk, size_t pos) const {
+    const unsigned char c = static_cast<unsigned char>(chunk[pos]);
+    std::string what = c >= 0x20 && c < 0x7f ? std::string("'") + static_cast<char>(c) + "'"
+                                             : "byte " + std::to_string(c);
+    throw JsonParsingException("Unexpected " + what + " in JSON at offset " + std::to_string(bytes_fed_ + pos));
+}
+
+} // namespace json
+} // namespace license_core
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "simple_json.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Push parser for JSON that arrives in chunks, e.g. a license body read from a
+// socket. feed() consumes each chunk as it comes and keeps only the object's
+// significant bytes; whitespace and the chunks themselves are not retained.
+// The SafeJsonParser limits are enforced while consuming, so an oversized or
+// malformed body is rejected at the first offending byte rather than after
+// the whole of it has been buffered.
+namespace license_core {
+namespace json {
+
+class IncrementalParser {
+public:
+    IncrementalParser() = default;
+
+    IncrementalParser(const IncrementalParser&) = delete;
+    IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+    // Consume the next chunk. Throws JsonSizeException once the total input
+    // exceeds MAX_JSON_SIZE and JsonParsingException for malformed input or
+    // any other limit; the parser must then be reset() before reuse.
+    void feed(std::string_view chunk);
+
+    // End of input: throws JsonParsingException unless a complete object has
+    // been fed, then parses it into doc. doc views into this parser and stays
+    // valid until the next reset().
+    void finish(JsonDocumentView& doc);
+
+    // The object fed so far without insignificant whitespace. Once complete()
+    // it parses to the same document as the original input, and a license in
+    // this form verifies like the original.
+    const std::string& json() const noexcept { return json_; }
+
+    bool complete() const noexcept { return state_ == State::Done; }
+    size_t bytes_fed() const noexcept { return bytes_fed_; }
+
+    // Ready for the next body; keeps the buffer's capacity
+    void reset() noexcept;
+
+private:
+    enum class State : uint8_t {
+        Start,      // before '{'
+        KeyOrEnd,   // after '{'
+        Key,        // after ',' between fields
+        Colon,
+        Value,
+        String,     // inside a quoted key, value or item
+        Scalar,     // inside an unquoted value
+        AfterValue,
+        ItemOrEnd,  // after '['
+        Item,       // after ',' between items
+        ItemScalar, // inside an unquoted item
+        AfterItem,
+        Done,       // only whitespace may follow
+        Failed
+    };
+
+    enum class StringKind : uint8_t { Key, Value, Item };
+
+    void consume(std::string_view chunk);
+    void begin_string(StringKind kind);
+    void end_string();
+    void append_token(std::string_view bytes);
+    [[noreturn]] void unexpected(std::string_view chunk, size_t pos) const;
+
+    std::string json_;
+    State state_ = State::Start;
+    StringKind string_kind_ = StringKind::Key;
+    bool escape_pending_ = false;
+    bool array_empty_ = true;
+    size_t token_length_ = 0; // raw bytes of the current string or scalar
+    size_t field_count_ = 0;
+    size_t item_count_ = 0;   // string items of the current array
+    size_t bytes_fed_ = 0;
+};
+
+} // namespace json
+} // namespace license_core
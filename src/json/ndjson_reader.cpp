@@ -0,0 +1,194 @@
+#include "ndjson_reader.hpp"
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace license_core {
+namespace json {
+
+namespace {
+
+bool is_blank(std::string_view line) {
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+// read(2) retried on EINTR; 0 at end of file
+size_t read_some(int fd, char* out, size_t capacity) {
+    for (;;) {
+#if defined(_WIN32)
+        int n = _read(fd, out, static_cast<unsigned>(capacity));
+#else
+        ssize_t n = ::read(fd, out, capacity);
+#endif
+        if (n >= 0) {
+            return static_cast<size_t>(n);
+        }
+        if (errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(), "NDJSON read failed");
+        }
+    }
+}
+
+} // namespace
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::string& path) {
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Cannot open " + path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size)) {
+        DWORD error = GetLastError();
+        CloseHandle(file_);
+        throw std::system_error(static_cast<int>(error), std::system_category(), "Cannot stat " + path);
+    }
+    if (size.QuadPart == 0) {
+        return;
+    }
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr) {
+        DWORD error = GetLastError();
+        if (mapping_) CloseHandle(mapping_);
+        CloseHandle(file_);
+        throw std::system_error(static_cast<int>(error), std::system_category(), "Cannot map " + path);
+    }
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<size_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_) CloseHandle(file_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+    }
+    if (info.st_size > 0) {
+        void* view = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+        }
+        // One front-to-back pass: let the kernel read ahead and drop pages behind
+        ::madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(view);
+        size_ = static_cast<size_t>(info.st_size);
+    }
+    ::close(fd); // the mapping keeps the file referenced
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+#endif
+
+NdjsonReader::NdjsonReader(std::string_view data)
+    : data_(data.data()), end_(data.size()), eof_(true) {
+}
+
+NdjsonReader::NdjsonReader(int fd)
+    : data_(nullptr), fd_(fd), buffer_(new char[READ_BUFFER_SIZE]) {
+    data_ = buffer_.get();
+}
+
+bool NdjsonReader::next(NdjsonRecord& record) {
+    for (;;) {
+        // Record boundaries come from memchr, which the C libraries we target
+        // implement with SSE2/AVX2 (NEON on ARM)
+        const char* start = data_ + begin_;
+        const void* newline = begin_ < end_ ? std::memchr(start, '\n', end_ - begin_) : nullptr;
+        size_t length;
+        if (newline != nullptr) {
+            length = static_cast<size_t>(static_cast<const char*>(newline) - start);
+            begin_ += length + 1;
+        } else if (!eof_) {
+            if (end_ - begin_ > SafeJsonParser::MAX_JSON_SIZE) {
+                skip_oversized_line();
+                throw JsonSizeException("NDJSON record exceeds maximum allowed size: line " +
+                                        std::to_string(line_) + " > " +
+                                        std::to_string(SafeJsonParser::MAX_JSON_SIZE) + " bytes");
+            }
+            fill();
+            continue;
+        } else if (begin_ < end_) {
+            length = end_ - begin_; // last line without a line break
+            begin_ = end_;
+        } else {
+            return false;
+        }
+
+        ++line_;
+        std::string_view text(start, length);
+        if (!text.empty() && text.back() == '\r') {
+            text.remove_suffix(1);
+        }
+        if (is_blank(text)) {
+            continue;
+        }
+
+        record.line = line_;
+        record.text = text;
+        SimpleJson::parse_view(text, record.doc);
+        return true;
+    }
+}
+
+bool NdjsonReader::fill() {
+    // Keep the partial line, then read after it
+    if (begin_ > 0) {
+        std::memmove(buffer_.get(), buffer_.get() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    size_t n = read_some(fd_, buffer_.get() + end_, READ_BUFFER_SIZE - end_);
+    end_ += n;
+    eof_ = n == 0;
+    return n != 0;
+}
+
+void NdjsonReader::skip_oversized_line() {
+    ++line_;
+    begin_ = end_ = 0;
+    while (fill()) {
+        if (const void* newline = std::memchr(buffer_.get(), '\n', end_)) {
+            begin_ = static_cast<size_t>(static_cast<const char*>(newline) - buffer_.get()) + 1;
+            return;
+        }
+        end_ = 0;
+    }
+}
+
+} // namespace json
+} // namespace license_core
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "simple_json.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Streaming reader for newline-delimited JSON (one object per line), as used
+// by bulk license exports. Records are parsed in place with
+// SimpleJson::parse_view, so a reused record costs no allocation, and memory
+// stays bounded by one read buffer however large the input is.
+namespace license_core {
+namespace json {
+
+struct NdjsonRecord {
+    size_t line = 0;       // 1-based line number in the input
+    std::string_view text; // the line without its line break
+    JsonDocumentView doc;  // views into text; valid until the next record
+};
+
+// Read-only mapping of a whole file; throws std::system_error on failure
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view data() const noexcept { return {data_, size_}; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
+
+class NdjsonReader {
+public:
+    // Records from memory, e.g. MappedFile::data(); the bytes must outlive the reader
+    explicit NdjsonReader(std::string_view data);
+
+    // Records from a file descriptor the caller keeps open, read in chunks
+    // into a buffer of READ_BUFFER_SIZE bytes
+    explicit NdjsonReader(int fd);
+
+    NdjsonReader(const NdjsonReader&) = delete;
+    NdjsonReader& operator=(const NdjsonReader&) = delete;
+
+    // Room for the largest record parse_view accepts plus a read chunk
+    static constexpr size_t READ_BUFFER_SIZE = 2 * SafeJsonParser::MAX_JSON_SIZE;
+
+    // Parse the next non-blank line into record; false at the end of input.
+    // A bad record throws what parse_view throws (JsonSizeException for a
+    // line over the size limit, which is skipped without being buffered).
+    // The reader has already moved past it, so the caller may catch, report
+    // line() and keep reading. Read errors throw std::system_error.
+    bool next(NdjsonRecord& record);
+
+    // f(const NdjsonRecord&) for every remaining record; returns how many
+    template <typename Func>
+    size_t for_each(Func&& f) {
+        NdjsonRecord record;
+        size_t count = 0;
+        while (next(record)) {
+            f(static_cast<const NdjsonRecord&>(record));
+            ++count;
+        }
+        return count;
+    }
+
+    // Line number of the last record returned or rejected
+    size_t line() const noexcept { return line_; }
+
+private:
+    bool fill();
+    void skip_oversized_line();
+
+    const char* data_;
+    size_t begin_ = 0; // unread bytes are data_[begin_, end_)
+    size_t end_ = 0;
+    size_t line_ = 0;
+    int fd_ = -1;      // -1 when reading from memory
+    bool eof_ = false;
+    std::unique_ptr<char[]> buffer_;
+};
+
+} // namespace json
+} // namespace license_core
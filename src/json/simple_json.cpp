@@ -1,233 +1,717 @@
 #include "simple_json.hpp"
-#include <sstream>
+#include "simd/cpu_features.hpp"
+#include "simd/json_escape.hpp"
+#include "canonical_writer.hpp"
 #include <algorithm>
+#include <charconv>
+#include <cstdio>
 #include <cctype>
 #include <limits>
+#include <cstring>
 
 namespace license_core {
 namespace json {
 
-std::unordered_map<std::string, JsonValue> SimpleJson::parse(const std::string& json_str) {
-    std::unordered_map<std::string, JsonValue> result;
+namespace {
+
+using detail::CanonicalWriter;
+using detail::ESCAPES;
+
+constexpr std::string_view WHITESPACE = " \t\n\r";
+
+// Same set as std::isspace in the "C" locale, without the locale lookup
+inline bool is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+size_t skip_whitespace(std::string_view str, size_t pos) {
+    while (pos < str.length() && is_space(str[pos])) {
+        pos++;
+    }
+    return pos;
+}
+
+std::string_view trim_view(std::string_view str) {
+    auto start = str.find_first_not_of(WHITESPACE);
+    if (start == std::string_view::npos) return {};
     
-    try {
-        // Security: Validate JSON size
-        SafeJsonParser::validate_size(json_str.size());
-        
-        // Remove outer braces and whitespace
-        std::string content = trim(json_str);
-        if (content.empty() || content.front() != '{' || content.back() != '}') {
-            throw JsonParsingException("Invalid JSON format: missing outer braces");
+    auto end = str.find_last_not_of(WHITESPACE);
+    return str.substr(start, end - start + 1);
+}
+
+// Scan a quoted string starting just after its opening quote; pos ends on the
+// closing quote (or past the end if unterminated)
+JsonStringView scan_string(std::string_view content, size_t& pos) {
+    JsonStringView view;
+    size_t start = pos;
+    
+    // Fast path: memchr to the next quote; a backslash-free run is the whole string
+    const char* base = content.data();
+    const void* quote = std::memchr(base + pos, '"', content.length() - pos);
+    size_t end = quote ? static_cast<const char*>(quote) - base : content.length();
+    if (std::memchr(base + pos, '\\', end - pos) == nullptr) {
+        pos = end;
+        view.raw = content.substr(start, end - start);
+        return view;
+    }
+    
+    while (pos < content.length() && content[pos] != '"') {
+        if (content[pos] == '\\' && pos + 1 < content.length()) {
+            view.escaped = true;
+            pos += 2; // skip escaped character
+        } else {
+            pos++;
         }
+    }
+    view.raw = content.substr(start, std::min(pos, content.length()) - start);
+    return view;
+}
+
+void unescape_into(std::string_view str, std::string& result) {
+    result.clear();
+    result.reserve(str.length());
+    
+    for (size_t i = 0; i < str.length(); ++i) {
+        if (str[i] == '\\' && i + 1 < str.length()) {
+            switch (str[i + 1]) {
+                case '"': result += '"'; ++i; break;
+                case '\\': result += '\\'; ++i; break;
+                case 'b': result += '\b'; ++i; break;
+                case 'f': result += '\f'; ++i; break;
+                case 'n': result += '\n'; ++i; break;
+                case 'r': result += '\r'; ++i; break;
+                case 't': result += '\t'; ++i; break;
+                default: result += str[i]; break;
+            }
+        } else {
+            result += str[i];
+        }
+    }
+}
+
+// stringify() runs twice over the same output: SizeCounter measures it
+// exactly, then BufferWriter fills a string of that size. Both escape whole
+// spans between the bytes simd::find_json_escape() reports.
+class SizeCounter {
+public:
+    void put(std::string_view s) { size_ += s.size(); }
+    
+    void put_escaped(std::string_view s) {
+        size_ += s.size();
+        for (size_t i = simd::find_json_escape(s.data(), s.size()); i < s.size();
+             i += 1 + simd::find_json_escape(s.data() + i + 1, s.size() - i - 1)) {
+            ++size_; // the backslash
+        }
+    }
+    
+    size_t size() const { return size_; }
+    
+private:
+    size_t size_ = 0;
+};
+
+class BufferWriter {
+public:
+    explicit BufferWriter(char* out) : out_(out) {}
+    
+    void put(std::string_view s) {
+        std::memcpy(out_, s.data(), s.size());
+        out_ += s.size();
+    }
+    
+    void put_escaped(std::string_view s) {
+        for (;;) {
+            size_t run = simd::find_json_escape(s.data(), s.size());
+            put(s.substr(0, run));
+            if (run == s.size()) {
+                return;
+            }
+            out_[0] = '\\';
+            out_[1] = ESCAPES[s[run]];
+            out_ += 2;
+            s.remove_prefix(run + 1);
+        }
+    }
+    
+private:
+    char* out_;
+};
+
+using JsonEntry = std::pair<const std::string, JsonValue>;
+
+// Numbers as std::ostream prints them with default flags
+std::string_view format_number(int value, char (&buffer)[32]) {
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string_view(buffer, result.ptr - buffer);
+}
+
+std::string_view format_number(double value, char (&buffer)[32]) {
+    int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    return std::string_view(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+}
+
+template <typename Out>
+void write_object(const JsonEntry* const* order, size_t count, Out& out) {
+    out.put("{\n");
+    
+    for (size_t i = 0; i < count; ++i) {
+        if (i != 0) out.put(",\n");
         
-        content = content.substr(1, content.length() - 2);
-        
-        // Parse with security checks
-        size_t pos = 0;
-        size_t object_key_count = 0;
+        out.put("  \"");
+        out.put_escaped(order[i]->first);
+        out.put("\": ");
         
-        while (pos < content.length()) {
-            // Security: Check object size limit
-            SafeJsonParser::validate_object_size(object_key_count);
-            
-            // Skip whitespace safely
-            pos = SafeJsonParser::skip_whitespace(content, pos);
-            
-            if (pos >= content.length()) break;
-            
-            // Find key with bounds checking
-            if (SafeJsonParser::safe_char_at(content, pos) != '"') {
-                // Skip to next comma or end
-                while (pos < content.length() && content[pos] != ',') pos++;
-                if (pos < content.length()) pos++;
-                continue;
+        std::visit([&out](const auto& v) {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string>) {
+                out.put("\"");
+                out.put_escaped(v);
+                out.put("\"");
             }
-            
-            pos++; // skip opening quote
-            size_t key_start = pos;
-            
-            // Find closing quote with escape handling
-            while (pos < content.length() && content[pos] != '"') {
-                if (content[pos] == '\\' && pos + 1 < content.length()) {
-                    pos += 2; // skip escaped character
-                } else {
-                    pos++;
+            else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+                out.put("[");
+                bool array_first = true;
+                for (const auto& item : v) {
+                    if (!array_first) out.put(", ");
+                    array_first = false;
+                    out.put("\"");
+                    out.put_escaped(item);
+                    out.put("\"");
                 }
+                out.put("]");
             }
-            
-            if (pos >= content.length()) {
-                throw JsonParsingException("Unterminated string in JSON key");
+            else if constexpr (std::is_same_v<T, bool>) {
+                out.put(v ? "true" : "false");
             }
-            
-            std::string key = content.substr(key_start, pos - key_start);
-            SafeJsonParser::validate_string_length(key.length());
-            pos++; // skip closing quote
-            
-            // Skip whitespace and colon
-            pos = SafeJsonParser::skip_whitespace(content, pos);
-            if (pos >= content.length() || content[pos] != ':') {
-                throw JsonParsingException("Missing colon after JSON key");
+            else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, double>) {
+                char buffer[32];
+                out.put(format_number(v, buffer));
+            }
+            else if constexpr (std::is_same_v<T, std::unordered_map<std::string, std::string>>) {
+                // Skip unsupported type for now
+                out.put("\"unsupported_map\"");
+            }
+            else {
+                // Fallback - convert to string if possible
+                out.put("\"unknown_type\"");
+            }
+        }, order[i]->second);
+    }
+    
+    out.put("\n}");
+}
+
+// Inputs at least this long are indexed with the SIMD structural scanner
+// first; below it, building the index costs more than it saves
+constexpr size_t INDEX_THRESHOLD = 1024;
+
+bool simd_index_available() {
+    static const bool available = simd::cpu_features().sse42 || simd::cpu_features().avx2;
+    return available;
+}
+
+// Byte-at-a-time scanning, cheapest for license-sized input
+class DirectScanner {
+public:
+    explicit DirectScanner(std::string_view content) : content_(content) {}
+    
+    size_t skip_ws(size_t pos) const { return skip_whitespace(content_, pos); }
+    JsonStringView string_at(size_t& pos) const { return scan_string(content_, pos); }
+    
+    // Next ',' (or the end)
+    size_t find_comma(size_t pos) const {
+        while (pos < content_.length() && content_[pos] != ',') pos++;
+        return pos;
+    }
+    
+    // Next ',' or ']' (or the end)
+    size_t find_item_end(size_t pos) const {
+        while (pos < content_.length() && content_[pos] != ',' && content_[pos] != ']') pos++;
+        return pos;
+    }
+    
+    // Next ',' or '}' (or the end)
+    size_t find_value_end(size_t pos) const {
+        while (pos < content_.length() && content_[pos] != ',' && content_[pos] != '}') pos++;
+        return pos;
+    }
+    
+private:
+    std::string_view content_;
+};
+
+// Same searches as DirectScanner answered from the classified blocks: each
+// is a masked bit scan, 64 bytes per step
+class IndexedScanner {
+public:
+    IndexedScanner(std::string_view content, const simd::JsonBlockMasks* blocks)
+        : content_(content), blocks_(blocks), block_count_(simd::json_block_count(content.size())) {}
+    
+    size_t skip_ws(size_t pos) const {
+        // Most runs are empty or a few bytes; test the first byte before the bit scan
+        if (pos < content_.length() && !is_space(content_[pos])) {
+            return pos;
+        }
+        return next(pos, [](const simd::JsonBlockMasks& b) { return ~b.whitespace; });
+    }
+    size_t find_comma(size_t pos) const { return find_delimiter(pos, ',', ','); }
+    size_t find_item_end(size_t pos) const { return find_delimiter(pos, ',', ']'); }
+    size_t find_value_end(size_t pos) const { return find_delimiter(pos, ',', '}'); }
+    
+    // scan_string() semantics: a backslash skips the byte after it
+    JsonStringView string_at(size_t& pos) const {
+        JsonStringView view;
+        const size_t start = pos;
+        for (;;) {
+            pos = next(pos, [](const simd::JsonBlockMasks& b) { return b.string; });
+            if (pos >= content_.length() || content_[pos] == '"') {
+                break;
+            }
+            if (pos + 1 < content_.length()) {
+                view.escaped = true;
+                pos += 2;
+            } else {
+                pos++;
+            }
+        }
+        view.raw = content_.substr(start, std::min(pos, content_.length()) - start);
+        return view;
+    }
+    
+private:
+    // Next a or b among the flagged , ] } bytes (or the end)
+    size_t find_delimiter(size_t pos, char a, char b) const {
+        for (;; ++pos) {
+            pos = next(pos, [](const simd::JsonBlockMasks& m) { return m.delimiter; });
+            if (pos >= content_.length() || content_[pos] == a || content_[pos] == b) {
+                return pos;
+            }
+        }
+    }
+    
+    // First position >= pos whose bit is set in select(block), or the end
+    template <typename Select>
+    size_t next(size_t pos, Select select) const {
+        if (pos >= content_.length()) {
+            return content_.length();
+        }
+        size_t block = pos / simd::JSON_BLOCK_SIZE;
+        uint64_t mask = select(blocks_[block]) & (~uint64_t(0) << (pos % simd::JSON_BLOCK_SIZE));
+        while (mask == 0) {
+            if (++block == block_count_) {
+                return content_.length();
             }
-            pos++; // skip colon
-            pos = SafeJsonParser::skip_whitespace(content, pos);
+            mask = select(blocks_[block]);
+        }
+        return std::min(block * simd::JSON_BLOCK_SIZE + simd::lowest_set_bit(mask), content_.length());
+    }
+    
+    std::string_view content_;
+    const simd::JsonBlockMasks* blocks_;
+    size_t block_count_;
+};
+
+} // namespace
+
+std::string JsonStringView::str() const {
+    if (!escaped) {
+        return std::string(raw);
+    }
+    std::string result;
+    unescape_into(raw, result);
+    return result;
+}
+
+const JsonFieldView* JsonDocumentView::find(std::string_view key) const noexcept {
+    for (auto it = fields_.rbegin(); it != fields_.rend(); ++it) {
+        if (it->key == key) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+bool JsonDocumentView::get_string(std::string_view key, std::string_view& out, std::string& scratch) const {
+    const JsonFieldView* field = find(key);
+    if (field == nullptr || field->type != JsonFieldView::Type::String) {
+        return false;
+    }
+    if (field->value.escaped) {
+        unescape_into(field->value.raw, scratch);
+        out = scratch;
+    } else {
+        out = field->value.raw;
+    }
+    return true;
+}
+
+std::string JsonDocumentView::get_string(std::string_view key, const std::string& default_value) const {
+    const JsonFieldView* field = find(key);
+    if (field == nullptr || field->type != JsonFieldView::Type::String) {
+        return default_value;
+    }
+    return field->value.str();
+}
+
+std::vector<std::string> JsonDocumentView::get_string_array(std::string_view key) const {
+    std::vector<std::string> values;
+    const JsonFieldView* field = find(key);
+    if (field != nullptr && field->type == JsonFieldView::Type::Array) {
+        values.reserve(field->item_count);
+        for (size_t i = 0; i < field->item_count; ++i) {
+            values.push_back(items(*field)[i].str());
+        }
+    }
+    return values;
+}
+
+JsonDocumentView SimpleJson::parse_view(std::string_view json) {
+    JsonDocumentView doc;
+    parse_view(json, doc);
+    return doc;
+}
+
+void SimpleJson::parse_view(std::string_view json, JsonDocumentView& doc) {
+    parse_view(json, doc, Scan::Auto);
+}
+
+void SimpleJson::parse_view(std::string_view json, JsonDocumentView& doc, Scan scan) {
+    doc.clear();
+    if (doc.fields_.capacity() == 0) {
+        // A license has about ten fields; start big enough to never regrow
+        doc.fields_.reserve(16);
+        doc.items_.reserve(16);
+    }
+    
+    // Security: Validate JSON size
+    SafeJsonParser::validate_size(json.size());
+    
+    // Remove outer braces and whitespace
+    std::string_view content = trim_view(json);
+    if (content.empty() || content.front() != '{' || content.back() != '}') {
+        throw JsonParsingException("Invalid JSON format: missing outer braces");
+    }
+    
+    content = content.substr(1, content.length() - 2);
+    
+    const bool indexed = scan == Scan::Indexed ||
+        (scan == Scan::Auto && content.size() >= INDEX_THRESHOLD && simd_index_available());
+    if (indexed) {
+        doc.index_.resize(simd::json_block_count(content.size()));
+        simd::classify_json(content.data(), content.size(), doc.index_.data());
+        parse_fields(IndexedScanner(content, doc.index_.data()), content, doc);
+    } else {
+        parse_fields(DirectScanner(content), content, doc);
+    }
+}
+
+template <typename Scanner>
+void SimpleJson::parse_fields(const Scanner& scanner, std::string_view content, JsonDocumentView& doc) {
+    // Parse with security checks
+    size_t pos = 0;
+    size_t object_key_count = 0;
+    
+    while (pos < content.length()) {
+        // Security: Check object size limit
+        SafeJsonParser::validate_object_size(object_key_count);
+        
+        pos = scanner.skip_ws(pos);
+        
+        if (pos >= content.length()) break;
+        
+        // Find key
+        if (content[pos] != '"') {
+            // Skip to next comma or end
+            pos = scanner.find_comma(pos);
+            if (pos < content.length()) pos++;
+            continue;
+        }
+        
+        pos++; // skip opening quote
+        JsonFieldView field;
+        field.key = scanner.string_at(pos).raw;
+        
+        if (pos >= content.length()) {
+            throw JsonParsingException("Unterminated string in JSON key");
+        }
+        
+        SafeJsonParser::validate_string_length(field.key.length());
+        pos++; // skip closing quote
+        
+        // Skip whitespace and colon
+        pos = scanner.skip_ws(pos);
+        if (pos >= content.length() || content[pos] != ':') {
+            throw JsonParsingException("Missing colon after JSON key");
+        }
+        pos++; // skip colon
+        pos = scanner.skip_ws(pos);
+        
+        if (pos >= content.length()) {
+            throw JsonParsingException("Missing value after JSON key");
+        }
+        
+        // Parse value with security checks
+        if (content[pos] == '"') {
+            // String value
+            pos++;
+            field.type = JsonFieldView::Type::String;
+            field.value = scanner.string_at(pos);
             
             if (pos >= content.length()) {
-                throw JsonParsingException("Missing value after JSON key");
+                throw JsonParsingException("Unterminated string in JSON value");
             }
             
-            // Parse value with security checks
-            if (SafeJsonParser::safe_char_at(content, pos) == '"') {
-                // String value
-                pos++;
-                size_t value_start = pos;
-                while (pos < content.length() && content[pos] != '"') {
-                    if (content[pos] == '\\' && pos + 1 < content.length()) {
-                        pos += 2; // skip escaped character
-                    } else {
-                        pos++;
-                    }
-                }
+            SafeJsonParser::validate_string_length(field.value.raw.length());
+            pos++; // skip closing quote
+        }
+        else if (content[pos] == '[') {
+            // Array value
+            pos++;
+            field.type = JsonFieldView::Type::Array;
+            field.first_item = doc.items_.size();
+            
+            while (pos < content.length() && content[pos] != ']') {
+                SafeJsonParser::validate_array_size(field.item_count);
                 
-                if (pos >= content.length()) {
-                    throw JsonParsingException("Unterminated string in JSON value");
-                }
+                pos = scanner.skip_ws(pos);
                 
-                std::string str_val = content.substr(value_start, pos - value_start);
-                SafeJsonParser::validate_string_length(str_val.length());
-                result[key] = unescape_json_string(str_val);
-                pos++; // skip closing quote
-            }
-            else if (SafeJsonParser::safe_char_at(content, pos) == '[') {
-                // Array value
-                pos++;
-                std::vector<std::string> array_values;
-                
-                while (pos < content.length() && content[pos] != ']') {
-                    SafeJsonParser::validate_array_size(array_values.size());
-                    
-                    pos = SafeJsonParser::skip_whitespace(content, pos);
+                if (pos < content.length() && content[pos] == '"') {
+                    pos++;
+                    JsonStringView item = scanner.string_at(pos);
                     
-                    if (pos < content.length() && content[pos] == '"') {
-                        pos++;
-                        size_t item_start = pos;
-                        while (pos < content.length() && content[pos] != '"') {
-                            if (content[pos] == '\\' && pos + 1 < content.length()) {
-                                pos += 2;
-                            } else {
-                                pos++;
-                            }
-                        }
-                        
-                        if (pos >= content.length()) {
-                            throw JsonParsingException("Unterminated string in JSON array");
-                        }
-                        
-                        std::string item = content.substr(item_start, pos - item_start);
-                        SafeJsonParser::validate_string_length(item.length());
-                        array_values.push_back(unescape_json_string(item));
-                        pos++;
+                    if (pos >= content.length()) {
+                        throw JsonParsingException("Unterminated string in JSON array");
                     }
                     
-                    pos = SafeJsonParser::skip_whitespace(content, pos);
-                    if (pos < content.length() && content[pos] == ',') {
-                        pos++;
-                    }
-                }
-                
-                result[key] = array_values;
-                if (pos < content.length()) pos++; // skip ]
-            }
-            else {
-                // Number, boolean, or other
-                size_t value_start = pos;
-                while (pos < content.length() && content[pos] != ',' && content[pos] != '}') {
+                    SafeJsonParser::validate_string_length(item.raw.length());
+                    doc.items_.push_back(item);
+                    field.item_count++;
                     pos++;
+                } else {
+                    // Non-string items are not part of the license format; skip them
+                    pos = scanner.find_item_end(pos);
                 }
-                std::string value_str = trim(content.substr(value_start, pos - value_start));
-                SafeJsonParser::validate_string_length(value_str.length());
                 
-                if (value_str == "true" || value_str == "false") {
-                    result[key] = (value_str == "true");
-                } else {
-                    result[key] = value_str;
+                pos = scanner.skip_ws(pos);
+                if (pos < content.length() && content[pos] == ',') {
+                    pos++;
                 }
             }
             
-            // Skip to next field
-            pos = SafeJsonParser::skip_whitespace(content, pos);
-            if (pos < content.length() && content[pos] == ',') {
-                pos++;
-            }
+            if (pos < content.length()) pos++; // skip ]
+        }
+        else {
+            // Number, boolean, or other
+            size_t value_start = pos;
+            pos = scanner.find_value_end(pos);
+            std::string_view value_str = trim_view(content.substr(value_start, pos - value_start));
+            SafeJsonParser::validate_string_length(value_str.length());
             
-            object_key_count++;
+            if (value_str == "true" || value_str == "false") {
+                field.type = JsonFieldView::Type::Bool;
+                field.boolean = (value_str == "true");
+            } else {
+                // Kept verbatim as a string, escapes included
+                field.type = JsonFieldView::Type::String;
+                field.value.raw = value_str;
+            }
+        }
+        
+        doc.fields_.push_back(field);
+        
+        // Skip to next field
+        pos = scanner.skip_ws(pos);
+        if (pos < content.length() && content[pos] == ',') {
+            pos++;
+        }
+        
+        object_key_count++;
+    }
+}
+
+std::unordered_map<std::string, JsonValue> SimpleJson::to_map(const JsonDocumentView& doc) {
+    std::unordered_map<std::string, JsonValue> result;
+    
+    for (const auto& field : doc.fields()) {
+        JsonValue& value = result[std::string(field.key)];
+        switch (field.type) {
+            case JsonFieldView::Type::String:
+                value = field.value.str();
+                break;
+            case JsonFieldView::Type::Bool:
+                value = field.boolean;
+                break;
+            case JsonFieldView::Type::Array: {
+                std::vector<std::string> array_values;
+                array_values.reserve(field.item_count);
+                for (size_t i = 0; i < field.item_count; ++i) {
+                    array_values.push_back(doc.items(field)[i].str());
+                }
+                value = std::move(array_values);
+                break;
+            }
         }
+    }
+    
+    return result;
+}
+
+pmr::JsonObject SimpleJson::to_map(const JsonDocumentView& doc, std::pmr::memory_resource* resource) {
+    pmr::JsonObject result(resource);
+    result.reserve(doc.fields().size());
+    
+    // emplace rather than assign, so every value is built with the map's resource
+    for (const auto& field : doc.fields()) {
+        pmr::JsonValue& value = result[std::pmr::string(field.key, resource)];
+        switch (field.type) {
+            case JsonFieldView::Type::String:
+                if (field.value.escaped) {
+                    value.emplace<std::pmr::string>(field.value.str(), resource);
+                } else {
+                    value.emplace<std::pmr::string>(field.value.raw, resource);
+                }
+                break;
+            case JsonFieldView::Type::Bool:
+                value = field.boolean;
+                break;
+            case JsonFieldView::Type::Array: {
+                auto& array_values = value.emplace<std::pmr::vector<std::pmr::string>>(resource);
+                array_values.reserve(field.item_count);
+                for (size_t i = 0; i < field.item_count; ++i) {
+                    const JsonStringView& item = doc.items(field)[i];
+                    if (item.escaped) {
+                        array_values.emplace_back(item.str());
+                    } else {
+                        array_values.emplace_back(item.raw);
+                    }
+                }
+                break;
+            }
+        }
+    }
+    
+    return result;
+}
+
+std::unordered_map<std::string, JsonValue> SimpleJson::parse(const std::string& json_str) {
+    try {
+        JsonDocumentView doc;
+        parse_view(json_str, doc);
+        return to_map(doc);
         
     } catch (const JsonParsingException&) {
         throw; // Re-throw our JSON exceptions
     } catch (const std::exception& e) {
         throw JsonParsingException("JSON parsing error: " + std::string(e.what()));
     }
-    
-    return result;
 }
 
-std::string SimpleJson::stringify(const std::unordered_map<std::string, JsonValue>& data) {
-    std::ostringstream ss;
-    ss << "{\n";
+pmr::JsonObject SimpleJson::parse(const std::string& json_str, std::pmr::memory_resource* resource) {
+    try {
+        JsonDocumentView doc(resource);
+        parse_view(json_str, doc);
+        return to_map(doc, resource);
+        
+    } catch (const JsonParsingException&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw JsonParsingException("JSON parsing error: " + std::string(e.what()));
+    }
+}
 
+std::string SimpleJson::stringify(const std::unordered_map<std::string, JsonValue>& data) {
     // Canonical order keeps signatures stable across platforms/processes.
-    std::vector<std::string> keys;
-    keys.reserve(data.size());
-    for (const auto& [key, _] : data) {
-        keys.push_back(key);
+    // Entries are sorted by address, so no key is copied.
+    constexpr size_t INLINE_KEYS = 64;
+    const JsonEntry* inline_order[INLINE_KEYS];
+    std::vector<const JsonEntry*> spilled;
+    const JsonEntry** order = inline_order;
+    if (data.size() > INLINE_KEYS) {
+        spilled.resize(data.size());
+        order = spilled.data();
     }
-    std::sort(keys.begin(), keys.end());
+    
+    size_t count = 0;
+    for (const auto& entry : data) {
+        order[count++] = &entry;
+    }
+    std::sort(order, order + count, [](const JsonEntry* a, const JsonEntry* b) {
+        return a->first < b->first;
+    });
+    
+    // Exact size first, then one write into one allocation
+    SizeCounter counter;
+    write_object(order, count, counter);
+    
+    std::string result(counter.size(), '\0');
+    BufferWriter writer(&result[0]);
+    write_object(order, count, writer);
+    return result;
+}
 
+void SimpleJson::write_canonical_impl(const JsonDocumentView& doc, const std::string_view* exclude_key,
+                                      CanonicalSink sink, void* context) {
+    // parse_view() stops at MAX_OBJECT_KEYS + 1 fields, so the order fits on the stack
+    constexpr size_t MAX_FIELDS = 128;
+    static_assert(SafeJsonParser::MAX_OBJECT_KEYS < MAX_FIELDS, "canonical field order does not fit");
+    
+    const auto& fields = doc.fields();
+    if (fields.size() > MAX_FIELDS) {
+        SafeJsonParser::validate_object_size(fields.size());
+    }
+    
+    // Same key order as stringify(); equal keys keep document order so the
+    // last occurrence, the one to_map() keeps, ends each run
+    const JsonFieldView* order[MAX_FIELDS];
+    size_t count = 0;
+    for (const auto& field : fields) {
+        if (exclude_key == nullptr || field.key != *exclude_key) {
+            order[count++] = &field;
+        }
+    }
+    std::sort(order, order + count, [](const JsonFieldView* a, const JsonFieldView* b) {
+        int cmp = a->key.compare(b->key);
+        return cmp < 0 || (cmp == 0 && a < b);
+    });
+    
+    CanonicalWriter out(sink, context);
+    out.put("{\n");
+    
     bool first = true;
-    for (const auto& key : keys) {
-        const auto& value = data.at(key);
-        if (!first) ss << ",\n";
+    for (size_t i = 0; i < count; ++i) {
+        if (i + 1 < count && order[i + 1]->key == order[i]->key) {
+            continue;
+        }
+        const JsonFieldView& field = *order[i];
+        if (!first) out.put(",\n");
         first = false;
         
-        ss << "  \"" << escape_json_string(key) << "\": ";
+        out.put("  \"");
+        out.put_escaped(field.key);
+        out.put("\": ");
         
-        std::visit([&ss](const auto& v) {
-            using T = std::decay_t<decltype(v)>;
-            if constexpr (std::is_same_v<T, std::string>) {
-                ss << "\"" << escape_json_string(v) << "\"";
-            }
-            else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
-                ss << "[";
-                bool array_first = true;
-                for (const auto& item : v) {
-                    if (!array_first) ss << ", ";
-                    array_first = false;
-                    ss << "\"" << escape_json_string(item) << "\"";
+        switch (field.type) {
+            case JsonFieldView::Type::String:
+                out.put_string(field.value);
+                break;
+            case JsonFieldView::Type::Bool:
+                out.put(field.boolean ? "true" : "false");
+                break;
+            case JsonFieldView::Type::Array: {
+                out.put("[");
+                const JsonStringView* items = doc.items(field);
+                for (size_t j = 0; j < field.item_count; ++j) {
+                    if (j != 0) out.put(", ");
+                    out.put_string(items[j]);
                 }
-                ss << "]";
-            }
-            else if constexpr (std::is_same_v<T, bool>) {
-                ss << (v ? "true" : "false");
-            }
-            else if constexpr (std::is_same_v<T, int>) {
-                ss << v;
+                out.put("]");
+                break;
             }
-            else if constexpr (std::is_same_v<T, double>) {
-                ss << v;
-            }
-            else if constexpr (std::is_same_v<T, std::unordered_map<std::string, std::string>>) {
-                // Skip unsupported type for now
-                ss << "\"unsupported_map\"";
-            }
-            else {
-                // Fallback - convert to string if possible
-                ss << "\"unknown_type\"";
-            }
-        }, value);
+        }
     }
     
-    ss << "\n}";
-    return ss.str();
+    out.put("\n}");
+    out.flush();
 }
 
 std::string SimpleJson::get_string(const std::unordered_map<std::string, JsonValue>& data, 
@@ -258,55 +742,13 @@ bool SimpleJson::has_key(const std::unordered_map<std::string, JsonValue>& data,
     return data.find(key) != data.end();
 }
 
-std::string SimpleJson::trim(const std::string& str) {
-    auto start = str.find_first_not_of(" \t\n\r");
-    if (start == std::string::npos) return "";
-    
-    auto end = str.find_last_not_of(" \t\n\r");
-    return str.substr(start, end - start + 1);
-}
-
 std::string SimpleJson::escape_json_string(const std::string& str) {
-    std::string result;
-    result.reserve(str.length() + 10);
-    
-    for (char c : str) {
-        switch (c) {
-            case '"': result += "\\\""; break;
-            case '\\': result += "\\\\"; break;
-            case '\b': result += "\\b"; break;
-            case '\f': result += "\\f"; break;
-            case '\n': result += "\\n"; break;
-            case '\r': result += "\\r"; break;
-            case '\t': result += "\\t"; break;
-            default: result += c; break;
-        }
-    }
-    
-    return result;
-}
-
-std::string SimpleJson::unescape_json_string(const std::string& str) {
-    std::string result;
-    result.reserve(str.length());
-    
-    for (size_t i = 0; i < str.length(); ++i) {
-        if (str[i] == '\\' && i + 1 < str.length()) {
-            switch (str[i + 1]) {
-                case '"': result += '"'; ++i; break;
-                case '\\': result += '\\'; ++i; break;
-                case 'b': result += '\b'; ++i; break;
-                case 'f': result += '\f'; ++i; break;
-                case 'n': result += '\n'; ++i; break;
-                case 'r': result += '\r'; ++i; break;
-                case 't': result += '\t'; ++i; break;
-                default: result += str[i]; break;
-            }
-        } else {
-            result += str[i];
-        }
-    }
+    SizeCounter counter;
+    counter.put_escaped(str);
     
+    std::string result(counter.size(), '\0');
+    BufferWriter writer(&result[0]);
+    writer.put_escaped(str);
     return result;
 }
 
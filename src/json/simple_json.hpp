@@ -1,11 +1,15 @@
 #pragma once
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <variant>
 #include <stdexcept>
 #include <cstddef>
+#include <type_traits>
+#include "simd/json_index.hpp"
 
 namespace license_core {
 namespace json {
@@ -43,6 +47,23 @@ using JsonValue = std::variant<
     std::unordered_map<std::string, std::string>
 >;
 
+// The same shapes with every string and container allocated from a memory
+// resource, as returned by SimpleJson::parse(json, resource)
+namespace pmr {
+
+using JsonValue = std::variant<
+    std::pmr::string,
+    int,
+    double,
+    bool,
+    std::pmr::vector<std::pmr::string>,
+    std::pmr::unordered_map<std::pmr::string, std::pmr::string>
+>;
+
+using JsonObject = std::pmr::unordered_map<std::pmr::string, JsonValue>;
+
+} // namespace pmr
+
 // Safe JSON parser with strict validation
 class SafeJsonParser {
 public:
@@ -110,14 +131,105 @@ public:
     }
 };
 
+// Zero-copy parse result: every key and value is a view into the caller's
+// buffer, which must outlive the document. Escapes are left in place and only
+// resolved when a value that actually contains a backslash is read.
+struct JsonStringView {
+    std::string_view raw;  // bytes between the quotes, escapes untouched
+    bool escaped = false;  // raw contains a backslash
+    
+    std::string str() const; // unescaped copy
+};
+
+struct JsonFieldView {
+    enum class Type { String, Bool, Array };
+    
+    std::string_view key;   // raw key bytes, as parse() uses them
+    Type type = Type::String;
+    JsonStringView value;   // String; unquoted numbers are kept as strings like parse()
+    bool boolean = false;   // Bool
+    size_t first_item = 0;  // Array: range in JsonDocumentView::items()
+    size_t item_count = 0;
+};
+
+class JsonDocumentView {
+public:
+    JsonDocumentView() = default;
+    
+    // Field, item and index storage comes from resource, e.g. a LicenseArena
+    explicit JsonDocumentView(std::pmr::memory_resource* resource)
+        : fields_(resource), items_(resource), index_(resource) {}
+    
+    // Duplicate keys resolve to the last occurrence, matching parse()
+    const JsonFieldView* find(std::string_view key) const noexcept;
+    bool has_key(std::string_view key) const noexcept { return find(key) != nullptr; }
+    
+    // String contents without copying unless escaped, in which case they are
+    // unescaped into scratch. Returns false if the key is absent or not a string.
+    bool get_string(std::string_view key, std::string_view& out, std::string& scratch) const;
+    std::string get_string(std::string_view key, const std::string& default_value = "") const;
+    std::vector<std::string> get_string_array(std::string_view key) const;
+    
+    const std::pmr::vector<JsonFieldView>& fields() const noexcept { return fields_; }
+    const JsonStringView* items(const JsonFieldView& array) const noexcept {
+        return items_.data() + array.first_item;
+    }
+    
+    // Keeps capacity, so a reused document parses without allocating
+    void clear() noexcept {
+        fields_.clear();
+        items_.clear();
+    }
+    
+private:
+    friend class SimpleJson;
+    std::pmr::vector<JsonFieldView> fields_;
+    std::pmr::vector<JsonStringView> items_;
+    std::pmr::vector<simd::JsonBlockMasks> index_; // structural index of large inputs, reused
+};
+
 class SimpleJson {
 public:
     // Parse JSON string (simplified - handles only our license format)
     static std::unordered_map<std::string, JsonValue> parse(const std::string& json_str);
     
+    // Same result with the map, its strings and all parse scratch allocated
+    // from resource; with a warmed-up LicenseArena this touches no global heap
+    static pmr::JsonObject parse(const std::string& json_str, std::pmr::memory_resource* resource);
+    
+    // Same grammar and limits as parse(), without copying the input: fills doc
+    // with views into json. Throws the same exceptions as parse().
+    static void parse_view(std::string_view json, JsonDocumentView& doc);
+    static JsonDocumentView parse_view(std::string_view json);
+    
+    // Large inputs are first classified 64 bytes at a time by the SIMD
+    // structural scanner (simd/json_index.hpp) and the parse loop jumps
+    // between the flagged bytes; small ones are walked directly. Both give
+    // identical results; forcing one is meant for tests and benchmarks.
+    enum class Scan { Auto, Direct, Indexed };
+    static void parse_view(std::string_view json, JsonDocumentView& doc, Scan scan);
+    
+    // The map parse() would have returned for the same input
+    static std::unordered_map<std::string, JsonValue> to_map(const JsonDocumentView& doc);
+    static pmr::JsonObject to_map(const JsonDocumentView& doc, std::pmr::memory_resource* resource);
+    
     // Generate JSON string from map
     static std::string stringify(const std::unordered_map<std::string, JsonValue>& data);
     
+    // Stream the bytes stringify(to_map(doc)) would return, leaving out the
+    // field named exclude_key, without building the map or the string.
+    // write(const char* data, size_t length) is called with short chunks in order.
+    template <typename Write>
+    static void write_canonical(const JsonDocumentView& doc, std::string_view exclude_key, Write&& write) {
+        write_canonical_impl(doc, &exclude_key, &call_sink<std::remove_reference_t<Write>>,
+                             const_cast<void*>(static_cast<const void*>(&write)));
+    }
+    template <typename Write>
+    static void write_canonical(const JsonDocumentView& doc, Write&& write) {
+        write_canonical_impl(doc, nullptr, &call_sink<std::remove_reference_t<Write>>,
+                             const_cast<void*>(static_cast<const void*>(&write)));
+    }
+    
     // Helper to get string value
     static std::string get_string(const std::unordered_map<std::string, JsonValue>& data, 
                                   const std::string& key, 
@@ -132,9 +244,20 @@ public:
                         const std::string& key);
 
 private:
-    static std::string trim(const std::string& str);
     static std::string escape_json_string(const std::string& str);
-    static std::string unescape_json_string(const std::string& str);
+    
+    using CanonicalSink = void (*)(void* context, const char* data, size_t length);
+    
+    template <typename Write>
+    static void call_sink(void* context, const char* data, size_t length) {
+        (*static_cast<Write*>(context))(data, length);
+    }
+    
+    template <typename Scanner>
+    static void parse_fields(const Scanner& scanner, std::string_view content, JsonDocumentView& doc);
+    
+    static void write_canonical_impl(const JsonDocumentView& doc, const std::string_view* exclude_key,
+                                     CanonicalSink sink, void* context);
 };
 
 } // namespace json
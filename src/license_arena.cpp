@@ -0,0 +1,88 @@
+#include "license_core/license_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace license_core {
+
+// Header of each upstream allocation; the usable bytes follow it
+struct LicenseArena::Block {
+    Block* next;
+    size_t size;
+
+    unsigned char* data() noexcept { return reinterpret_cast<unsigned char*>(this + 1); }
+};
+
+LicenseArena::LicenseArena(size_t initial_size, std::pmr::memory_resource* upstream)
+    : upstream_(upstream),
+      next_block_size_(std::max<size_t>(initial_size, 256)) {
+    if (initial_size > 0) {
+        add_block(initial_size);
+    }
+}
+
+LicenseArena::~LicenseArena() {
+    Block* block = first_;
+    while (block != nullptr) {
+        Block* next = block->next;
+        upstream_->deallocate(block, sizeof(Block) + block->size, alignof(std::max_align_t));
+        block = next;
+    }
+}
+
+void LicenseArena::reset() noexcept {
+    current_ = first_;
+    offset_ = 0;
+    used_ = 0;
+}
+
+size_t LicenseArena::capacity() const noexcept {
+    size_t total = 0;
+    for (const Block* block = first_; block != nullptr; block = block->next) {
+        total += block->size;
+    }
+    return total;
+}
+
+size_t LicenseArena::used() const noexcept {
+    return used_;
+}
+
+void* LicenseArena::do_allocate(size_t bytes, size_t alignment) {
+    for (;;) {
+        if (current_ != nullptr) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(current_->data());
+            const size_t start = ((base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+            if (start <= current_->size && bytes <= current_->size - start) {
+                used_ += start - offset_ + bytes;
+                offset_ = start + bytes;
+                return current_->data() + start;
+            }
+            // Blocks kept from before a reset() are reused in order
+            if (current_->next != nullptr) {
+                current_ = current_->next;
+                offset_ = 0;
+                continue;
+            }
+        }
+        add_block(bytes + alignment);
+    }
+}
+
+LicenseArena::Block* LicenseArena::add_block(size_t min_size) {
+    const size_t size = std::max(next_block_size_, min_size);
+    void* memory = upstream_->allocate(sizeof(Block) + size, alignof(std::max_align_t));
+    Block* block = new (memory) Block{nullptr, size};
+
+    if (current_ != nullptr) {
+        current_->next = block;
+    } else {
+        first_ = block;
+    }
+    current_ = block;
+    offset_ = 0;
+    next_block_size_ = size * 2;
+    return block;
+}
+
+} // namespace license_core
@@ -0,0 +1,374 @@
+#include "license_binary.hpp"
+#include "license_decoder.hpp"
+#include "iso8601.hpp"
+#include "json/canonical_writer.hpp"
+#include "json/simple_json.hpp"
+#include "simd/hex.hpp"
+#include "license_core/exceptions.hpp"
+#include <charconv>
+#include <cstring>
+#include <vector>
+
+namespace license_core {
+namespace binary {
+
+namespace {
+
+// Header field offsets, see the layout in license_binary.hpp
+constexpr size_t FORMAT_VERSION_AT = 4;
+constexpr size_t FLAGS_AT = 6;
+constexpr size_t LICENSE_VERSION_AT = 8;
+constexpr size_t TOTAL_SIZE_AT = 12;
+constexpr size_t EXPIRY_AT = 16;
+constexpr size_t ISSUED_AT_AT = 24;
+constexpr size_t TABLE_OFFSET_AT = 32;
+constexpr size_t TABLE_SIZE_AT = 36;
+constexpr size_t FEATURE_LIST_AT = 40;
+constexpr size_t FEATURE_COUNT_AT = 44;
+constexpr size_t RESERVED_AT = 46;
+constexpr size_t MAC_AT = 48;
+
+constexpr size_t FIXED_STRINGS = 4; // user_id, license_id, hardware_hash, kid
+constexpr size_t MAX_STRING = 0xFFFF;
+
+// Timestamps system_clock can hold
+const int64_t MIN_SECONDS = std::chrono::duration_cast<std::chrono::seconds>(
+    std::chrono::system_clock::duration::min()).count() + 1;
+const int64_t MAX_SECONDS = std::chrono::duration_cast<std::chrono::seconds>(
+    std::chrono::system_clock::duration::max()).count() - 1;
+
+uint16_t load_u16(const unsigned char* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t load_u32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t load_u64(const unsigned char* p) {
+    return static_cast<uint64_t>(load_u32(p)) | (static_cast<uint64_t>(load_u32(p + 4)) << 32);
+}
+
+void store_u16(unsigned char* p, uint16_t v) {
+    p[0] = static_cast<unsigned char>(v);
+    p[1] = static_cast<unsigned char>(v >> 8);
+}
+
+void store_u32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+void store_u64(unsigned char* p, uint64_t v) {
+    store_u32(p, static_cast<uint32_t>(v));
+    store_u32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+constexpr size_t align4(size_t n) {
+    return (n + 3) & ~size_t(3);
+}
+
+[[noreturn]] void fail(const std::string& what) {
+    throw MalformedLicenseException("Binary license: " + what);
+}
+
+int64_t epoch_seconds(const std::chrono::system_clock::time_point& time_point) {
+    return static_cast<int64_t>(std::chrono::system_clock::to_time_t(time_point));
+}
+
+std::string encode(const LicenseInfo& info, uint16_t flags, const uint8_t* mac) {
+    std::vector<std::string_view> strings = {info.user_id, info.license_id, info.hardware_hash, info.key_id};
+    strings.insert(strings.end(), info.features.begin(), info.features.end());
+    if (info.features.size() > 0xFFFF) {
+        fail("too many features");
+    }
+
+    size_t table_size = 0;
+    for (std::string_view s : strings) {
+        if (s.size() > MAX_STRING) {
+            fail("string longer than 65535 bytes");
+        }
+        table_size += 2 + s.size();
+    }
+    const size_t list_offset = align4(HEADER_SIZE + table_size);
+    const size_t total = list_offset + 4 * info.features.size();
+    if (total > 0xFFFFFFFFu) {
+        fail("license too large");
+    }
+
+    std::string out(total, '\0');
+    auto* p = reinterpret_cast<unsigned char*>(&out[0]);
+    std::memcpy(p, MAGIC.data(), MAGIC.size());
+    store_u16(p + FORMAT_VERSION_AT, FORMAT_VERSION);
+    store_u16(p + FLAGS_AT, flags);
+    store_u32(p + LICENSE_VERSION_AT, (flags & HAS_VERSION) ? info.version : IMPLIED_VERSION);
+    store_u32(p + TOTAL_SIZE_AT, static_cast<uint32_t>(total));
+    store_u64(p + EXPIRY_AT, static_cast<uint64_t>(epoch_seconds(info.expiry)));
+    store_u64(p + ISSUED_AT_AT, (flags & HAS_ISSUED_AT) ? static_cast<uint64_t>(epoch_seconds(info.issued_at)) : 0);
+    store_u32(p + TABLE_OFFSET_AT, static_cast<uint32_t>(HEADER_SIZE));
+    store_u32(p + TABLE_SIZE_AT, static_cast<uint32_t>(table_size));
+    store_u32(p + FEATURE_LIST_AT, static_cast<uint32_t>(list_offset));
+    store_u16(p + FEATURE_COUNT_AT, static_cast<uint16_t>(info.features.size()));
+    std::memcpy(p + MAC_AT, mac, MAC_SIZE);
+
+    size_t pos = 0;
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (i >= FIXED_STRINGS) {
+            store_u32(p + list_offset + 4 * (i - FIXED_STRINGS), static_cast<uint32_t>(pos));
+        }
+        store_u16(p + HEADER_SIZE + pos, static_cast<uint16_t>(strings[i].size()));
+        std::memcpy(p + HEADER_SIZE + pos + 2, strings[i].data(), strings[i].size());
+        pos += 2 + strings[i].size();
+    }
+    return out;
+}
+
+} // namespace
+
+std::string_view LicenseView::feature(size_t index) const noexcept {
+    const unsigned char* entry = strings_ + load_u32(feature_offsets_ + 4 * index);
+    return std::string_view(reinterpret_cast<const char*>(entry + 2), load_u16(entry));
+}
+
+void decode(std::string_view data, LicenseView& out) {
+    if (data.size() < HEADER_SIZE || !is_binary_license(data)) {
+        fail("bad header");
+    }
+    const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+    if (load_u16(p + FORMAT_VERSION_AT) != FORMAT_VERSION) {
+        fail("unsupported format version");
+    }
+    out.flags = load_u16(p + FLAGS_AT);
+    if ((out.flags & ~KNOWN_FLAGS) != 0 || load_u16(p + RESERVED_AT) != 0) {
+        fail("unknown flags");
+    }
+    out.version = load_u32(p + LICENSE_VERSION_AT);
+    out.expiry = static_cast<int64_t>(load_u64(p + EXPIRY_AT));
+    out.issued_at = static_cast<int64_t>(load_u64(p + ISSUED_AT_AT));
+    if (out.expiry < MIN_SECONDS || out.expiry > MAX_SECONDS ||
+        out.issued_at < MIN_SECONDS || out.issued_at > MAX_SECONDS) {
+        fail("timestamp out of range");
+    }
+    out.mac = p + MAC_AT;
+    // Fields left out of the signed form must hold their implied values, so
+    // they cannot be changed under a valid MAC
+    if ((!(out.flags & HAS_VERSION) && out.version != IMPLIED_VERSION) ||
+        (!(out.flags & HAS_ISSUED_AT) && out.issued_at != 0)) {
+        fail("inconsistent layout");
+    }
+
+    // One canonical layout: table right after the header, feature list after
+    // the table padded to 4 bytes, nothing after the list
+    const size_t table_offset = load_u32(p + TABLE_OFFSET_AT);
+    const size_t table_size = load_u32(p + TABLE_SIZE_AT);
+    const size_t list_offset = load_u32(p + FEATURE_LIST_AT);
+    const size_t feature_count = load_u16(p + FEATURE_COUNT_AT);
+    if (load_u32(p + TOTAL_SIZE_AT) != data.size() || table_offset != HEADER_SIZE ||
+        table_size > data.size() - HEADER_SIZE || list_offset != align4(HEADER_SIZE + table_size) ||
+        list_offset > data.size() || (data.size() - list_offset) / 4 != feature_count ||
+        (data.size() - list_offset) % 4 != 0) {
+        fail("inconsistent layout");
+    }
+    for (size_t i = HEADER_SIZE + table_size; i < list_offset; ++i) {
+        if (p[i] != 0) {
+            fail("inconsistent layout");
+        }
+    }
+
+    const unsigned char* table = p + table_offset;
+    const unsigned char* list = p + list_offset;
+    size_t pos = 0;
+    auto next_string = [&]() {
+        if (table_size - pos < 2 || table_size - pos - 2 < load_u16(table + pos)) {
+            fail("string table out of bounds");
+        }
+        std::string_view s(reinterpret_cast<const char*>(table + pos + 2), load_u16(table + pos));
+        pos += 2 + s.size();
+        return s;
+    };
+    out.user_id = next_string();
+    out.license_id = next_string();
+    out.hardware_hash = next_string();
+    out.key_id = next_string();
+    for (size_t i = 0; i < feature_count; ++i) {
+        if (load_u32(list + 4 * i) != pos) {
+            fail("feature list out of order");
+        }
+        next_string();
+    }
+    if (pos != table_size) {
+        fail("string table out of bounds");
+    }
+    out.strings_ = table;
+    out.feature_offsets_ = list;
+    out.feature_count_ = feature_count;
+
+    if (!(out.flags & HAS_KEY_ID) && !out.key_id.empty()) {
+        fail("key id without flag");
+    }
+    // Same checks and messages as the JSON decoder
+    if (out.user_id.empty()) {
+        throw MalformedLicenseException("user_id cannot be empty");
+    }
+    if (out.license_id.empty()) {
+        throw MalformedLicenseException("license_id cannot be empty");
+    }
+    if (out.hardware_hash.empty()) {
+        throw MalformedLicenseException("hardware_hash cannot be empty");
+    }
+}
+
+namespace detail {
+
+void write_canonical_impl(const LicenseView& view, CanonicalSink sink, void* context) {
+    json::detail::CanonicalWriter out(sink, context);
+    using std::chrono::system_clock;
+
+    // Keys in stringify() order; none of them needs escaping
+    bool first = true;
+    auto key = [&](std::string_view name) {
+        out.put(first ? "{\n  \"" : ",\n  \"");
+        first = false;
+        out.put(name);
+        out.put("\": ");
+    };
+    auto string_value = [&](std::string_view value) {
+        out.put("\"");
+        out.put_escaped(value);
+        out.put("\"");
+    };
+    auto date_value = [&](int64_t seconds) {
+        char date[iso8601::FORMAT_BUFFER_SIZE];
+        size_t length = iso8601::format_to(system_clock::from_time_t(static_cast<std::time_t>(seconds)), date);
+        out.put("\"");
+        out.put(std::string_view(date, length));
+        out.put("\"");
+    };
+
+    key("expiry");
+    date_value(view.expiry);
+    key("features");
+    out.put("[");
+    for (size_t i = 0; i < view.feature_count(); ++i) {
+        if (i != 0) out.put(", ");
+        string_value(view.feature(i));
+    }
+    out.put("]");
+    key("hardware_hash");
+    string_value(view.hardware_hash);
+    if (view.flags & HAS_ISSUED_AT) {
+        key("issued_at");
+        date_value(view.issued_at);
+    }
+    if (view.flags & HAS_KEY_ID) {
+        key("kid");
+        string_value(view.key_id);
+    }
+    key("license_id");
+    string_value(view.license_id);
+    key("user_id");
+    string_value(view.user_id);
+    if (view.flags & HAS_VERSION) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), view.version);
+        key("version");
+        string_value(std::string_view(digits, result.ptr - digits));
+    }
+    out.put("\n}");
+    out.flush();
+}
+
+} // namespace detail
+
+std::string from_json(std::string_view license_json) {
+    using decoder::LicenseField;
+
+    json::JsonDocumentView doc;
+    json::SimpleJson::parse_view(license_json, doc);
+    decoder::DecodedLicense decoded;
+    decoder::decode_license(doc, decoded);
+    const LicenseInfo& info = decoded.info;
+
+    // Only what the binary form can give back exactly
+    std::string scratch;
+    for (const json::JsonFieldView& field : doc.fields()) {
+        const LicenseField id = decoder::license_field(field.key);
+        if (id == LicenseField::Unknown) {
+            fail("field has no binary encoding: " + std::string(field.key));
+        }
+        const auto expected = id == LicenseField::Features ? json::JsonFieldView::Type::Array
+                                                           : json::JsonFieldView::Type::String;
+        // Unquoted numbers parse as strings; the closing quote tells them apart
+        const char* after = field.value.raw.data() + field.value.raw.size();
+        const bool quoted = field.type != json::JsonFieldView::Type::String ||
+                            (after < license_json.data() + license_json.size() && *after == '"');
+        if (field.type != expected || !quoted) {
+            fail("unexpected value type: " + std::string(field.key));
+        }
+    }
+    auto require_text = [&](std::string_view key, const std::string& canonical) {
+        std::string_view text;
+        doc.get_string(key, text, scratch);
+        if (text != canonical) {
+            fail("non-canonical " + std::string(key) + ": " + std::string(text));
+        }
+    };
+
+    uint16_t flags = 0;
+    require_text("expiry", iso8601::format(info.expiry));
+    if (decoded.present & decoder::field_bit(LicenseField::IssuedAt)) {
+        flags |= HAS_ISSUED_AT;
+        require_text("issued_at", iso8601::format(info.issued_at));
+    }
+    if (decoded.present & decoder::field_bit(LicenseField::KeyId)) {
+        flags |= HAS_KEY_ID;
+    }
+    if (decoded.present & decoder::field_bit(LicenseField::Version)) {
+        flags |= HAS_VERSION;
+        require_text("version", std::to_string(info.version));
+    }
+
+    HMACValidator::Digest mac;
+    if (!HMACValidator::decode_signature(decoded.signature, mac)) {
+        fail("invalid hmac_signature");
+    }
+    require_text("hmac_signature", simd::hex_encode(mac.data(), mac.size()));
+
+    return encode(info, flags, mac.data());
+}
+
+std::string to_json(std::string_view binary_license) {
+    LicenseView view;
+    decode(binary_license, view);
+
+    std::unordered_map<std::string, json::JsonValue> fields;
+    auto time_point = [](int64_t seconds) {
+        return std::chrono::system_clock::from_time_t(static_cast<std::time_t>(seconds));
+    };
+    fields["user_id"] = std::string(view.user_id);
+    fields["license_id"] = std::string(view.license_id);
+    fields["hardware_hash"] = std::string(view.hardware_hash);
+    fields["expiry"] = iso8601::format(time_point(view.expiry));
+    std::vector<std::string> features;
+    for (size_t i = 0; i < view.feature_count(); ++i) {
+        features.emplace_back(view.feature(i));
+    }
+    fields["features"] = std::move(features);
+    if (view.flags & HAS_ISSUED_AT) {
+        fields["issued_at"] = iso8601::format(time_point(view.issued_at));
+    }
+    if (view.flags & HAS_KEY_ID) {
+        fields["kid"] = std::string(view.key_id);
+    }
+    if (view.flags & HAS_VERSION) {
+        fields["version"] = std::to_string(view.version);
+    }
+    fields["hmac_signature"] = simd::hex_encode(view.mac, MAC_SIZE);
+
+    return json::SimpleJson::stringify(fields);
+}
+
+} // namespace binary
+} // namespace license_core
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "license_core/license_manager.hpp"
+#include "license_core/hmac_validator.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Compact binary license encoding. Decoding is bounds-checked pointer
+// arithmetic over the caller's buffer and never allocates, so a license can be
+// validated straight from an mmap'd file. All integers are little-endian.
+//
+//   offset  size  field
+//        0     4  magic "LCB1"
+//        4     2  format version (1)
+//        6     2  flags (Flag)
+//        8     4  license version
+//       12     4  total size in bytes
+//       16     8  expiry, signed seconds since the Unix epoch
+//       24     8  issued_at, same
+//       32     4  string table offset
+//       36     4  string table size
+//       40     4  feature list offset, 4-byte aligned
+//       44     2  feature count
+//       46     2  reserved, 0
+//       48    32  MAC
+//       80        string table: u16 length + bytes each for user_id,
+//                 license_id, hardware_hash, kid, then every feature;
+//                 feature list: u32 string table offset per feature
+//
+// The MAC is the license's HMAC-SHA256 over the canonical JSON form, i.e. the
+// bytes of "hmac_signature". Both encodings verify with the same key and
+// signature, and convert into each other without it.
+namespace license_core {
+namespace binary {
+
+constexpr std::string_view MAGIC = "LCB1";
+constexpr uint16_t FORMAT_VERSION = 1;
+constexpr size_t HEADER_SIZE = 80;
+constexpr size_t MAC_SIZE = HMACValidator::DIGEST_SIZE;
+
+// Optional schema fields that were present in the JSON form
+enum Flag : uint16_t {
+    HAS_ISSUED_AT = 1 << 0,
+    HAS_KEY_ID = 1 << 1,
+    HAS_VERSION = 1 << 2,
+};
+
+constexpr uint16_t KNOWN_FLAGS = HAS_ISSUED_AT | HAS_KEY_ID | HAS_VERSION;
+
+// License version when HAS_VERSION is clear, as for JSON without "version";
+// issued_at is then 0, and kid empty without HAS_KEY_ID
+constexpr uint32_t IMPLIED_VERSION = 1;
+
+inline bool is_binary_license(std::string_view data) noexcept {
+    return data.substr(0, MAGIC.size()) == MAGIC;
+}
+
+// Decoded license; strings point into the buffer given to decode()
+struct LicenseView {
+    uint16_t flags = 0;
+    uint32_t version = 1;
+    int64_t expiry = 0;    // seconds since the epoch
+    int64_t issued_at = 0;
+    std::string_view user_id;
+    std::string_view license_id;
+    std::string_view hardware_hash;
+    std::string_view key_id;
+    const uint8_t* mac = nullptr; // MAC_SIZE bytes
+
+    size_t feature_count() const noexcept { return feature_count_; }
+    std::string_view feature(size_t index) const noexcept; // index < feature_count()
+
+private:
+    friend void decode(std::string_view data, LicenseView& out);
+    const unsigned char* strings_ = nullptr;
+    const unsigned char* feature_offsets_ = nullptr;
+    size_t feature_count_ = 0;
+};
+
+// Validate the layout and fill out. Throws MalformedLicenseException on any
+// structural error and, like the JSON decoder, for empty identifiers.
+void decode(std::string_view data, LicenseView& out);
+
+// LicenseInfo or pmr::LicenseInfo; reuses the target's string capacity
+template <typename Info>
+void to_info(const LicenseView& view, Info& info) {
+    using std::chrono::system_clock;
+    info.user_id.assign(view.user_id);
+    info.license_id.assign(view.license_id);
+    info.hardware_hash.assign(view.hardware_hash);
+    info.key_id.assign(view.key_id);
+    info.features.resize(view.feature_count());
+    for (size_t i = 0; i < view.feature_count(); ++i) {
+        info.features[i].assign(view.feature(i));
+    }
+    info.expiry = system_clock::from_time_t(static_cast<std::time_t>(view.expiry));
+    info.issued_at = (view.flags & HAS_ISSUED_AT)
+                         ? system_clock::from_time_t(static_cast<std::time_t>(view.issued_at))
+                         : system_clock::time_point();
+    info.version = view.version;
+}
+
+// Stream the canonical signed form of the license, byte for byte what
+// SimpleJson::write_canonical gives for its JSON form without "hmac_signature"
+template <typename Write>
+void write_canonical(const LicenseView& view, Write&& write);
+
+// Lossless for every schema field and the signature. from_json throws
+// MalformedLicenseException for JSON the binary form could not reproduce:
+// unknown fields, non-string values, or dates, version and signature not in
+// the canonical text generate_license writes. to_json writes that layout.
+std::string from_json(std::string_view license_json);
+std::string to_json(std::string_view binary_license);
+
+namespace detail {
+
+using CanonicalSink = void (*)(void* context, const char* data, size_t length);
+
+template <typename Write>
+void call_sink(void* context, const char* data, size_t length) {
+    (*static_cast<Write*>(context))(data, length);
+}
+
+void write_canonical_impl(const LicenseView& view, CanonicalSink sink, void* context);
+
+} // namespace detail
+
+template <typename Write>
+void write_canonical(const LicenseView& view, Write&& write) {
+    detail::write_canonical_impl(view, &detail::call_sink<std::remove_reference_t<Write>>,
+                                 const_cast<void*>(static_cast<const void*>(&write)));
+}
+
+} // namespace binary
+} // namespace license_core
@@ -0,0 +1,99 @@
+#include "license_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+namespace license_core {
+
+namespace {
+
+uint64_t hash_bytes(std::string_view bytes) {
+    return static_cast<uint64_t>(std::hash<std::string_view>{}(bytes));
+}
+
+} // namespace
+
+LicenseCache::LicenseCache(size_t capacity, size_t shard_count)
+    : shard_count_(std::max<size_t>(1, std::min(shard_count, std::max<size_t>(1, capacity)))) {
+    shard_capacity_ = std::max<size_t>(1, (capacity + shard_count_ - 1) / shard_count_);
+    shards_ = std::make_unique<Shard[]>(shard_count_);
+}
+
+LicenseCache::Shard& LicenseCache::shard_for(uint64_t hash) const {
+    // The low bits already feed the per-shard map, so the shard comes from the
+    // high half of a multiplicative mix. Folding first keeps this spread when
+    // std::hash is only 32 bits wide and the upper half of hash is zero.
+    const uint64_t mixed = (hash ^ (hash >> 32)) * 0x9e3779b97f4a7c15ull;
+    return shards_[(mixed >> 32) % shard_count_];
+}
+
+bool LicenseCache::lookup(std::string_view license_json, LicenseInfo& out) {
+    uint64_t hash = hash_bytes(license_json);
+    Shard& shard = shard_for(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(hash);
+    if (it == shard.index.end() || it->second->license_json != license_json) {
+        ++shard.misses;
+        return false;
+    }
+
+    // Entries are only valid until the license itself expires
+    if (std::chrono::system_clock::now() > it->second->info.expiry) {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+        ++shard.misses;
+        return false;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    ++shard.hits;
+    out = it->second->info;
+    return true;
+}
+
+void LicenseCache::insert(std::string_view license_json, const LicenseInfo& info) {
+    uint64_t hash = hash_bytes(license_json);
+    Shard& shard = shard_for(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(hash);
+    if (it != shard.index.end()) {
+        // Same bytes or a hash collision - either way the newest entry wins
+        it->second->license_json.assign(license_json.data(), license_json.size());
+        it->second->info = info;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    if (shard.lru.size() >= shard_capacity_) {
+        shard.index.erase(shard.lru.back().hash);
+        shard.lru.pop_back();
+        ++shard.evictions;
+    }
+
+    shard.lru.push_front(Entry{hash, std::string(license_json), info});
+    shard.index.emplace(hash, shard.lru.begin());
+}
+
+void LicenseCache::clear() {
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        shards_[i].lru.clear();
+        shards_[i].index.clear();
+    }
+}
+
+ValidationCacheStats LicenseCache::stats() const {
+    ValidationCacheStats stats;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        stats.cache_hits += shards_[i].hits;
+        stats.cache_misses += shards_[i].misses;
+        stats.evictions += shards_[i].evictions;
+        stats.entries += shards_[i].lru.size();
+    }
+    return stats;
+}
+
+} // namespace license_core
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "license_core/license_manager.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace license_core {
+
+// Bounded cache of successfully validated licenses, keyed by a hash of the raw
+// license bytes. Split into independently locked LRU shards so concurrent
+// lookups rarely contend. A hit requires the stored bytes to match exactly and
+// the license to be unexpired; the hash only selects the slot.
+class LicenseCache {
+public:
+    LicenseCache(size_t capacity, size_t shard_count);
+
+    // Copy the cached info for license_json into out; false on a miss
+    bool lookup(std::string_view license_json, LicenseInfo& out);
+    void insert(std::string_view license_json, const LicenseInfo& info);
+    void clear();
+
+    ValidationCacheStats stats() const;
+
+private:
+    struct Entry {
+        uint64_t hash;
+        std::string license_json;
+        LicenseInfo info;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru; // most recently used first
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    size_t shard_count_;
+    size_t shard_capacity_;
+    std::unique_ptr<Shard[]> shards_;
+
+    Shard& shard_for(uint64_t hash) const;
+};
+
+} // namespace license_core
@@ -0,0 +1,136 @@
+#include "license_decoder.hpp"
+#include "iso8601.hpp"
+#include "license_core/exceptions.hpp"
+
+namespace license_core {
+namespace decoder {
+
+namespace {
+
+// Non-string values read as empty, like SimpleJson::get_string
+template <typename String>
+void assign_string(const json::JsonFieldView& field, String& out) {
+    if (field.type != json::JsonFieldView::Type::String) {
+        out.clear();
+    } else if (field.value.escaped) {
+        out.assign(field.value.str());
+    } else {
+        out.assign(field.value.raw.data(), field.value.raw.size());
+    }
+}
+
+// Keeps the container's allocator for the new element
+template <typename Strings>
+void append_string(const json::JsonStringView& value, Strings& out) {
+    if (value.escaped) {
+        out.emplace_back(value.str());
+    } else {
+        out.emplace_back(value.raw);
+    }
+}
+
+// View of a string value, unescaping into scratch only when needed
+std::string_view string_value(const json::JsonFieldView& field, std::string& scratch) {
+    if (field.type != json::JsonFieldView::Type::String) {
+        return {};
+    }
+    if (field.value.escaped) {
+        scratch = field.value.str();
+        return scratch;
+    }
+    return field.value.raw;
+}
+
+} // namespace
+
+template <typename Info>
+void decode_license(const json::JsonDocumentView& doc, BasicDecodedLicense<Info>& out, bool detached) {
+    Info& info = out.info;
+    out.present = 0;
+
+    // Parsed after the required-field check so error precedence stays the same
+    const json::JsonFieldView* expiry = nullptr;
+    const json::JsonFieldView* issued_at = nullptr;
+    const json::JsonFieldView* version = nullptr;
+
+    for (const json::JsonFieldView& field : doc.fields()) {
+        const LicenseField id = license_field(field.key);
+        if (id == LicenseField::Unknown) {
+            continue;
+        }
+        if (out.present & field_bit(id)) {
+            throw MalformedLicenseException("Duplicate field: " + std::string(field.key));
+        }
+        out.present |= field_bit(id);
+
+        switch (id) {
+            case LicenseField::UserId:        assign_string(field, info.user_id); break;
+            case LicenseField::LicenseId:     assign_string(field, info.license_id); break;
+            case LicenseField::HardwareHash:  assign_string(field, info.hardware_hash); break;
+            case LicenseField::HmacSignature: assign_string(field, out.signature); break;
+            case LicenseField::KeyId:         assign_string(field, info.key_id); break;
+            case LicenseField::Expiry:        expiry = &field; break;
+            case LicenseField::IssuedAt:      issued_at = &field; break;
+            case LicenseField::Version:       version = &field; break;
+            case LicenseField::Features:
+                info.features.clear();
+                if (field.type == json::JsonFieldView::Type::Array) {
+                    info.features.reserve(field.item_count);
+                    for (size_t i = 0; i < field.item_count; ++i) {
+                        append_string(doc.items(field)[i], info.features);
+                    }
+                }
+                break;
+            case LicenseField::Unknown:
+                break;
+        }
+    }
+
+    for (LicenseField required : REQUIRED_FIELDS) {
+        if (detached && required == LicenseField::HmacSignature) {
+            continue;
+        }
+        if (!(out.present & field_bit(required))) {
+            throw MalformedLicenseException("Missing required field: " +
+                                            std::string(LICENSE_FIELD_NAMES[static_cast<size_t>(required)]));
+        }
+    }
+
+    // Validate basic field contents
+    if (info.user_id.empty()) {
+        throw MalformedLicenseException("user_id cannot be empty");
+    }
+    if (info.license_id.empty()) {
+        throw MalformedLicenseException("license_id cannot be empty");
+    }
+    if (info.hardware_hash.empty()) {
+        throw MalformedLicenseException("hardware_hash cannot be empty");
+    }
+
+    // Version is optional and defaults to 1
+    std::string scratch;
+    if (version != nullptr) {
+        try {
+            assign_string(*version, scratch);
+            info.version = std::stoul(scratch);
+        } catch (const std::exception&) {
+            throw MalformedLicenseException("Invalid version format");
+        }
+    }
+
+    try {
+        info.expiry = iso8601::parse(string_value(*expiry, scratch));
+
+        if (issued_at != nullptr) {
+            info.issued_at = iso8601::parse(string_value(*issued_at, scratch));
+        }
+    } catch (const std::exception&) {
+        throw MalformedLicenseException("Invalid date format");
+    }
+}
+
+template void decode_license(const json::JsonDocumentView&, DecodedLicense&, bool);
+template void decode_license(const json::JsonDocumentView&, pmr::DecodedLicense&, bool);
+
+} // namespace decoder
+} // namespace license_core
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "license_core/license_manager.hpp"
+#include "json/simple_json.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Decoder specialized for the license schema: one pass over the parsed fields,
+// a compile-time perfect hash from key to field, values written straight into
+// LicenseInfo, and a bitmask for missing and duplicate fields.
+namespace license_core {
+namespace decoder {
+
+enum class LicenseField : uint8_t {
+    UserId,
+    LicenseId,
+    Expiry,
+    IssuedAt,
+    HardwareHash,
+    Features,
+    HmacSignature,
+    Version,
+    KeyId,
+    Unknown
+};
+
+constexpr size_t LICENSE_FIELD_COUNT = static_cast<size_t>(LicenseField::Unknown);
+
+constexpr std::string_view LICENSE_FIELD_NAMES[LICENSE_FIELD_COUNT] = {
+    "user_id", "license_id", "expiry", "issued_at", "hardware_hash",
+    "features", "hmac_signature", "version", "kid"
+};
+
+constexpr uint32_t field_bit(LicenseField field) {
+    return 1u << static_cast<unsigned>(field);
+}
+
+// Required in every license, in the order load_and_validate reports them
+constexpr LicenseField REQUIRED_FIELDS[] = {
+    LicenseField::UserId, LicenseField::LicenseId, LicenseField::Expiry,
+    LicenseField::HardwareHash, LicenseField::Features, LicenseField::HmacSignature
+};
+
+namespace detail {
+
+constexpr size_t FIELD_TABLE_SIZE = 16;
+
+// Hash on length and first/last byte; the seed is searched at compile time
+constexpr size_t field_hash(std::string_view key, uint32_t seed) {
+    if (key.empty()) {
+        return 0;
+    }
+    uint32_t h = static_cast<uint8_t>(key.front()) * seed;
+    h ^= static_cast<uint8_t>(key.back()) + static_cast<uint32_t>(key.size()) * 31u;
+    return (h ^ (h >> 7)) % FIELD_TABLE_SIZE;
+}
+
+constexpr bool seed_is_perfect(uint32_t seed) {
+    bool used[FIELD_TABLE_SIZE] = {};
+    for (std::string_view name : LICENSE_FIELD_NAMES) {
+        size_t slot = field_hash(name, seed);
+        if (used[slot]) {
+            return false;
+        }
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t find_seed() {
+    for (uint32_t seed = 1; seed < 4096; ++seed) {
+        if (seed_is_perfect(seed)) {
+            return seed;
+        }
+    }
+    return 0;
+}
+
+constexpr uint32_t FIELD_SEED = find_seed();
+static_assert(FIELD_SEED != 0, "no perfect hash seed for the license field names");
+
+constexpr std::array<LicenseField, FIELD_TABLE_SIZE> build_field_table() {
+    std::array<LicenseField, FIELD_TABLE_SIZE> table{};
+    for (auto& slot : table) {
+        slot = LicenseField::Unknown;
+    }
+    for (size_t i = 0; i < LICENSE_FIELD_COUNT; ++i) {
+        table[field_hash(LICENSE_FIELD_NAMES[i], FIELD_SEED)] = static_cast<LicenseField>(i);
+    }
+    return table;
+}
+
+constexpr std::array<LicenseField, FIELD_TABLE_SIZE> FIELD_TABLE = build_field_table();
+
+} // namespace detail
+
+// One hash, one table load and one compare
+constexpr LicenseField license_field(std::string_view key) {
+    LicenseField field = detail::FIELD_TABLE[detail::field_hash(key, detail::FIELD_SEED)];
+    if (field != LicenseField::Unknown && LICENSE_FIELD_NAMES[static_cast<size_t>(field)] == key) {
+        return field;
+    }
+    return LicenseField::Unknown;
+}
+
+// Info is LicenseInfo or pmr::LicenseInfo; the signature uses the same string type
+template <typename Info>
+struct BasicDecodedLicense {
+    using String = decltype(Info::user_id);
+    
+    BasicDecodedLicense() = default;
+    explicit BasicDecodedLicense(const typename String::allocator_type& alloc)
+        : info(alloc), signature(alloc) {}
+    
+    Info info;
+    String signature;      // hex "hmac_signature"
+    uint32_t present = 0;  // field_bit() of every schema field seen
+};
+
+using DecodedLicense = BasicDecodedLicense<LicenseInfo>;
+
+namespace pmr {
+using DecodedLicense = BasicDecodedLicense<license_core::pmr::LicenseInfo>;
+} // namespace pmr
+
+// Fill out from a parsed document. Throws MalformedLicenseException with the
+// same messages as the generic path (missing or empty fields, bad version or
+// dates), plus "Duplicate field" when a schema field appears twice. Expiry,
+// signature and hardware checks are left to the caller. A detached payload
+// (signature in an envelope header) does not require "hmac_signature".
+// Instantiated for DecodedLicense and pmr::DecodedLicense.
+template <typename Info>
+void decode_license(const json::JsonDocumentView& doc, BasicDecodedLicense<Info>& out, bool detached = false);
+
+} // namespace decoder
+} // namespace license_core
@@ -2,41 +2,20 @@
 #include "license_core/hardware_fingerprint.hpp"
 #include "license_core/hmac_validator.hpp"
 #include "json/simple_json.hpp"
+#include "license_cache.hpp"
+#include "license_snapshot.hpp"
+#include "iso8601.hpp"
+#include "license_decoder.hpp"
+#include "license_binary.hpp"
 #include <chrono>
-#include <sstream>
-#include <iomanip>
 #include <algorithm>
-#include <ctime>
+#include <atomic>
+#include <mutex>
 #include <stdexcept>
+#include <utility>
 
 namespace license_core {
 
-namespace {
-
-std::time_t to_utc_time_t(std::tm* utc_tm) {
-#ifdef _WIN32
-    return _mkgmtime(utc_tm);
-#else
-    return timegm(utc_tm);
-#endif
-}
-
-std::tm gmtime_safe(std::time_t time_value) {
-    std::tm tm{};
-#ifdef _WIN32
-    if (gmtime_s(&tm, &time_value) != 0) {
-        throw std::runtime_error("Failed to convert time");
-    }
-#else
-    if (gmtime_r(&time_value, &tm) == nullptr) {
-        throw std::runtime_error("Failed to convert time");
-    }
-#endif
-    return tm;
-}
-
-} // namespace
-
 // PIMPL implementation
 class LicenseManager::Impl {
 public:
@@ -46,117 +25,214 @@ public:
           hardware_fingerprint_(std::make_unique<HardwareFingerprint>(hardware_config_)) {
     }
     
+    explicit Impl(const HMACValidator& validator)
+        : hardware_config_(),
+          hmac_validator_(validator),
+          hardware_fingerprint_(std::make_unique<HardwareFingerprint>(hardware_config_)) {
+    }
+    
     HardwareConfig hardware_config_;
     HMACValidator hmac_validator_;
     std::unique_ptr<HardwareFingerprint> hardware_fingerprint_;
-    LicenseInfo current_license_;
+    LicenseSnapshot current_license_; // read wait-free by the feature checks
+    std::string current_hwid_; // fingerprint scratch, reused across validations
     bool strict_validation_ = false;
+    std::unique_ptr<LicenseCache> validation_cache_; // null when disabled
+    
+    // register_feature names with their hashes, index = FeatureId. Their bits
+    // in the current license, plus LICENSE_VALID_BIT, are republished by
+    // every reload in one store.
+    static constexpr uint64_t LICENSE_VALID_BIT = uint64_t(1) << MAX_REGISTERED_FEATURES;
+    std::mutex registry_mutex_;
+    std::vector<std::pair<std::string, uint64_t>> registered_features_;
+    std::atomic<uint64_t> registered_bits_{0};
+    
+    // Make a new license current, then republish the registered feature bits
+    template <typename Fill>
+    void publish(Fill&& fill) {
+        current_license_.publish(fill);
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        registered_bits_.store(registered_bits(current_license_.latest(), current_license_.latest_features()),
+                               std::memory_order_release);
+    }
+    
+    // Caller holds registry_mutex_
+    uint64_t registered_bits(const LicenseInfo& license, const FeatureSet& features) const {
+        if (!license.valid) {
+            return 0;
+        }
+        uint64_t bits = LICENSE_VALID_BIT;
+        for (size_t i = 0; i < registered_features_.size(); ++i) {
+            const auto& [name, hash] = registered_features_[i];
+            if (features.contains(name, hash)) {
+                bits |= uint64_t(1) << i;
+            }
+        }
+        return bits;
+    }
+    
+    // The check a well-formed license failed, None if it passed
+    enum class CheckError : uint8_t {
+        None,
+        BadEnvelope,      // malformed header, unknown kid or MAC mismatch
+        KeyIdMismatch,    // envelope kid differs from the license's kid
+        UnknownKeyId,
+        Expired,
+        BadSignature,
+        HardwareMismatch,
+    };
+    
+    // This machine's fingerprint into hwid; throws HardwareDetectionException
+    void probe_hwid(std::string& hwid) const {
+        try {
+            hardware_fingerprint_->get_fingerprint(hwid);
+        } catch (const HardwareDetectionException& e) {
+            throw HardwareDetectionException("Failed to get current hardware fingerprint: " + std::string(e.what()));
+        }
+    }
+    
+    // Parse, signature, expiry and fingerprint checks, shared by every
+    // validation path; hwid is this machine's fingerprint from probe_hwid.
+    // Touches no manager state, so any number of threads may run it at once.
+    // Returns the first failed check without throwing (reason gets the detail
+    // for BadEnvelope); only a malformed payload throws. On success
+    // decoded.info is valid.
+    template <typename Info>
+    CheckError check(const std::string& license_json, json::JsonDocumentView& document,
+                     decoder::BasicDecodedLicense<Info>& decoded, const std::string& hwid,
+                     const char** reason = nullptr) const;
+    
+    // check, throwing the matching LicenseException for a failed check
+    template <typename Info>
+    void check_or_throw(const std::string& license_json, json::JsonDocumentView& document,
+                        decoder::BasicDecodedLicense<Info>& decoded, const std::string& hwid) const;
+    
+    // check_or_throw, then make decoded.info the current license (load_and_validate)
+    template <typename Info>
+    void validate(const std::string& license_json, json::JsonDocumentView& document,
+                  decoder::BasicDecodedLicense<Info>& decoded);
+    
+    // Cached results depend on the keys and the hardware identity
+    void flush_validation_cache() {
+        if (validation_cache_) {
+            validation_cache_->clear();
+        }
+    }
 };
 
 LicenseManager::LicenseManager(const std::string& secret_key) 
     : pimpl_(std::make_unique<Impl>(secret_key)) {
 }
 
+LicenseManager::LicenseManager(const HMACValidator& validator)
+    : pimpl_(std::make_unique<Impl>(validator)) {
+}
+
 LicenseManager::~LicenseManager() = default;
 
-LicenseInfo LicenseManager::load_and_validate(const std::string& license_json) {
-    LicenseInfo info;
-    info.valid = false;
-    
+namespace {
+
+// Copy between LicenseInfo and pmr::LicenseInfo, reusing the target's
+// string capacity so a steady-state reload does not allocate
+template <typename To, typename From>
+void assign_license(To& to, const From& from) {
+    to.user_id.assign(from.user_id);
+    to.hardware_hash.assign(from.hardware_hash);
+    to.features.resize(from.features.size());
+    for (size_t i = 0; i < from.features.size(); ++i) {
+        to.features[i].assign(from.features[i]);
+    }
+    to.expiry = from.expiry;
+    to.issued_at = from.issued_at;
+    to.license_id.assign(from.license_id);
+    to.version = from.version;
+    to.key_id.assign(from.key_id);
+    to.valid = from.valid;
+    to.error_message.assign(from.error_message);
+}
+
+} // namespace
+
+template <typename Info>
+LicenseManager::Impl::CheckError
+LicenseManager::Impl::check(const std::string& license_json, json::JsonDocumentView& document,
+                            decoder::BasicDecodedLicense<Info>& decoded, const std::string& hwid,
+                            const char** reason) const {
     try {
-        // Parse JSON using our simple parser
-        auto license_data = json::SimpleJson::parse(license_json);
-        
-        // Check for required fields
-        std::vector<std::string> required_fields = {
-            "user_id", "license_id", "expiry", "hardware_hash", 
-            "features", "hmac_signature"
-        };
-        
-        for (const auto& field : required_fields) {
-            if (!json::SimpleJson::has_key(license_data, field)) {
-                throw MalformedLicenseException("Missing required field: " + field);
+        // Detached-signature envelope: MAC the raw payload bytes first, so
+        // forged or garbage input never reaches the parser
+        std::string_view payload = license_json;
+        std::string_view envelope_kid;
+        const bool detached = HMACValidator::is_envelope(license_json);
+        if (detached) {
+            const char* error = hmac_validator_.try_open_envelope(license_json, payload, envelope_kid);
+            if (error) {
+                if (reason) {
+                    *reason = error;
+                }
+                return CheckError::BadEnvelope;
             }
         }
         
-        // Extract basic fields
-        info.user_id = json::SimpleJson::get_string(license_data, "user_id");
-        info.license_id = json::SimpleJson::get_string(license_data, "license_id");
-        info.hardware_hash = json::SimpleJson::get_string(license_data, "hardware_hash");
-        info.features = json::SimpleJson::get_string_array(license_data, "features");
-        
-        // Validate basic field contents
-        if (info.user_id.empty()) {
-            throw MalformedLicenseException("user_id cannot be empty");
-        }
-        if (info.license_id.empty()) {
-            throw MalformedLicenseException("license_id cannot be empty");
-        }
-        if (info.hardware_hash.empty()) {
-            throw MalformedLicenseException("hardware_hash cannot be empty");
-        }
-        
-        // Parse version (optional, defaults to 1)
-        if (json::SimpleJson::has_key(license_data, "version")) {
-            try {
-                std::string version_str = json::SimpleJson::get_string(license_data, "version");
-                info.version = std::stoul(version_str);
-            } catch (const std::exception&) {
-                throw MalformedLicenseException("Invalid version format");
-            }
+        // Binary licenses decode by bounds-checked reads over the input.
+        // Otherwise zero-copy parse, then decode the schema fields straight
+        // into info. Malformed licenses are rejected here without building a map.
+        const bool is_binary = binary::is_binary_license(payload);
+        binary::LicenseView view;
+        if (is_binary) {
+            binary::decode(payload, view);
+            binary::to_info(view, decoded.info);
+        } else {
+            json::SimpleJson::parse_view(payload, document);
+            decoder::decode_license(document, decoded, detached);
         }
+        Info& info = decoded.info;
         
-        // Parse dates with error handling
-        try {
-            std::string expiry_str = json::SimpleJson::get_string(license_data, "expiry");
-            info.expiry = parse_iso8601(expiry_str);
-            
-            if (json::SimpleJson::has_key(license_data, "issued_at")) {
-                std::string issued_str = json::SimpleJson::get_string(license_data, "issued_at");
-                info.issued_at = parse_iso8601(issued_str);
-            }
-        } catch (const std::exception&) {
-            throw MalformedLicenseException("Invalid date format");
+        if (detached && std::string_view(info.key_id) != envelope_kid) {
+            return CheckError::KeyIdMismatch;
         }
         
         // Check if license has expired
         auto now = std::chrono::system_clock::now();
         if (now > info.expiry) {
-            throw ExpiredLicenseException(format_iso8601(info.expiry));
+            return CheckError::Expired;
         }
         
-        // Verify signature
-        std::string signature = json::SimpleJson::get_string(license_data, "hmac_signature");
-        
-        // Create JSON without signature for verification
-        auto verification_data = license_data;
-        verification_data.erase("hmac_signature");
-        std::string data_to_verify = json::SimpleJson::stringify(verification_data);
-        
-        try {
-            if (!pimpl_->hmac_validator_.verify(data_to_verify, signature)) {
-                throw InvalidSignatureException("HMAC verification failed");
+        // Embedded signature: verify over the canonical form without
+        // "hmac_signature", streamed straight into the HMAC
+        if (!detached) {
+            const std::string kid(info.key_id);
+            if (!hmac_validator_.has_key(kid)) {
+                return CheckError::UnknownKeyId;
+            }
+            auto stream = hmac_validator_.begin_stream(kid);
+            HMACValidator::Digest expected;
+            auto update = [&stream](const char* data, size_t length) {
+                stream.update(data, length);
+            };
+            if (is_binary) {
+                std::copy(view.mac, view.mac + binary::MAC_SIZE, expected.begin());
+                binary::write_canonical(view, update);
+            } else {
+                if (!HMACValidator::decode_signature(decoded.signature, expected)) {
+                    return CheckError::BadSignature;
+                }
+                json::SimpleJson::write_canonical(document, "hmac_signature", update);
+            }
+            if (!stream.verify(expected)) {
+                return CheckError::BadSignature;
             }
-        } catch (const std::exception& e) {
-            throw InvalidSignatureException(std::string("Signature verification error: ") + e.what());
         }
         
         // Check hardware fingerprint
-        std::string current_hwid;
-        try {
-            current_hwid = pimpl_->hardware_fingerprint_->get_fingerprint();
-        } catch (const HardwareDetectionException& e) {
-            throw HardwareDetectionException("Failed to get current hardware fingerprint: " + std::string(e.what()));
-        }
-        
-        if (current_hwid != info.hardware_hash) {
-            throw HardwareMismatchException(info.hardware_hash, current_hwid);
+        if (hwid != std::string_view(info.hardware_hash)) {
+            return CheckError::HardwareMismatch;
         }
         
         // All checks passed
         info.valid = true;
         info.error_message.clear();
-        pimpl_->current_license_ = info;
+        return CheckError::None;
         
     } catch (const LicenseException&) {
         // Re-throw LicenseCore exceptions
@@ -165,34 +241,156 @@ LicenseInfo LicenseManager::load_and_validate(const std::string& license_json) {
         // Wrap other exceptions
         throw JsonParsingException(std::string("Unexpected error: ") + e.what());
     }
+}
+
+template <typename Info>
+void LicenseManager::Impl::check_or_throw(const std::string& license_json, json::JsonDocumentView& document,
+                                          decoder::BasicDecodedLicense<Info>& decoded, const std::string& hwid) const {
+    const Info& info = decoded.info;
+    const char* reason = nullptr;
+    switch (check(license_json, document, decoded, hwid, &reason)) {
+    case CheckError::None:
+        return;
+    case CheckError::BadEnvelope:
+        throw InvalidSignatureException(reason);
+    case CheckError::KeyIdMismatch:
+        throw InvalidSignatureException("Envelope key id does not match license kid");
+    case CheckError::UnknownKeyId:
+        throw InvalidSignatureException("Signature verification error: Unknown key id: " + std::string(info.key_id));
+    case CheckError::Expired:
+        throw ExpiredLicenseException(iso8601::format(info.expiry));
+    case CheckError::BadSignature:
+        throw InvalidSignatureException("Signature verification error: HMAC verification failed");
+    case CheckError::HardwareMismatch:
+        throw HardwareMismatchException(std::string(info.hardware_hash), hwid);
+    }
+}
+
+template <typename Info>
+void LicenseManager::Impl::validate(const std::string& license_json, json::JsonDocumentView& document,
+                                    decoder::BasicDecodedLicense<Info>& decoded) {
+    probe_hwid(current_hwid_);
+    check_or_throw(license_json, document, decoded, current_hwid_);
     
-    return info;
+    const Info& info = decoded.info;
+    publish([&info](LicenseInfo& next) {
+        assign_license(next, info);
+    });
+    
+    if (validation_cache_) {
+        validation_cache_->insert(license_json, current_license_.latest());
+    }
+}
+
+LicenseInfo LicenseManager::load_and_validate(const std::string& license_json) {
+    LicenseInfo info;
+    info.valid = false;
+    
+    if (pimpl_->validation_cache_ && pimpl_->validation_cache_->lookup(license_json, info)) {
+        pimpl_->publish([&info](LicenseInfo& next) {
+            next = info;
+        });
+        return info;
+    }
+    
+    json::JsonDocumentView document;
+    decoder::DecodedLicense decoded;
+    pimpl_->validate(license_json, document, decoded);
+    return std::move(decoded.info);
+}
+
+pmr::LicenseInfo LicenseManager::load_and_validate(const std::string& license_json,
+                                                   std::pmr::memory_resource* resource) {
+    if (pimpl_->validation_cache_) {
+        LicenseInfo cached;
+        if (pimpl_->validation_cache_->lookup(license_json, cached)) {
+            pimpl_->publish([&cached](LicenseInfo& next) {
+                next = cached;
+            });
+            pmr::LicenseInfo info(resource);
+            assign_license(info, cached);
+            return info;
+        }
+    }
+    
+    json::JsonDocumentView document(resource);
+    decoder::pmr::DecodedLicense decoded(resource);
+    pimpl_->validate(license_json, document, decoded);
+    return std::move(decoded.info);
 }
 
 bool LicenseManager::has_feature(const std::string& feature) const {
-    if (!pimpl_->current_license_.valid) {
+    LicenseSnapshot::ReadGuard license(pimpl_->current_license_);
+    if (!license->valid) {
+        if (pimpl_->strict_validation_) {
+            throw ValidationException("No valid license loaded");
+        }
+        return false;
+    }
+    
+    return license.features().contains(feature);
+}
+
+bool LicenseManager::has_feature(const FeatureName& feature) const {
+    LicenseSnapshot::ReadGuard license(pimpl_->current_license_);
+    if (!license->valid) {
         if (pimpl_->strict_validation_) {
             throw ValidationException("No valid license loaded");
         }
         return false;
     }
     
-    const auto& features = pimpl_->current_license_.features;
-    return std::find(features.begin(), features.end(), feature) != features.end();
+    return license.features().contains(feature.name(), feature.hash());
 }
 
 void LicenseManager::require_feature(const std::string& feature) const {
-    if (!pimpl_->current_license_.valid) {
-        throw ValidationException("No valid license loaded");
+    bool found;
+    {
+        LicenseSnapshot::ReadGuard license(pimpl_->current_license_);
+        if (!license->valid) {
+            throw ValidationException("No valid license loaded");
+        }
+        found = license.features().contains(feature);
     }
     
-    if (!has_feature(feature)) {
+    if (!found) {
         throw MissingFeatureException(feature);
     }
 }
 
-std::string LicenseManager::generate_license(const LicenseInfo& info) const {
-    // Validate input
+FeatureId LicenseManager::register_feature(const std::string& feature) {
+    auto& registry = pimpl_->registered_features_;
+    std::lock_guard<std::mutex> lock(pimpl_->registry_mutex_);
+    for (size_t i = 0; i < registry.size(); ++i) {
+        if (registry[i].first == feature) {
+            return FeatureId{static_cast<uint8_t>(i)};
+        }
+    }
+    if (registry.size() == MAX_REGISTERED_FEATURES) {
+        throw ValidationException("Cannot register more than " + std::to_string(MAX_REGISTERED_FEATURES) +
+                                  " features");
+    }
+    registry.emplace_back(feature, feature_hash(feature));
+    
+    // Bits for the license loaded now; later reloads include the new name
+    LicenseSnapshot::ReadGuard license(pimpl_->current_license_);
+    pimpl_->registered_bits_.store(pimpl_->registered_bits(*license, license.features()),
+                                   std::memory_order_release);
+    return FeatureId{static_cast<uint8_t>(registry.size() - 1)};
+}
+
+bool LicenseManager::has_feature(FeatureId feature) const {
+    const uint64_t bits = pimpl_->registered_bits_.load(std::memory_order_acquire);
+    if ((bits & Impl::LICENSE_VALID_BIT) == 0 && pimpl_->strict_validation_) {
+        throw ValidationException("No valid license loaded");
+    }
+    return feature.index < MAX_REGISTERED_FEATURES && ((bits >> feature.index) & 1);
+}
+
+namespace {
+
+// Unsigned license fields; throws ValidationException on missing identifiers
+std::unordered_map<std::string, json::JsonValue> license_fields(const LicenseInfo& info, const std::string& kid) {
     if (info.user_id.empty()) {
         throw ValidationException("user_id cannot be empty");
     }
@@ -203,17 +401,28 @@ std::string LicenseManager::generate_license(const LicenseInfo& info) const {
         throw ValidationException("hardware_hash cannot be empty");
     }
     
+    std::unordered_map<std::string, json::JsonValue> license_data;
+    
+    license_data["user_id"] = info.user_id;
+    license_data["license_id"] = info.license_id;
+    license_data["expiry"] = iso8601::format(info.expiry);
+    license_data["issued_at"] = iso8601::format(info.issued_at);
+    license_data["hardware_hash"] = info.hardware_hash;
+    license_data["features"] = info.features;
+    license_data["version"] = std::to_string(info.version);
+    
+    if (!kid.empty()) {
+        license_data["kid"] = kid;
+    }
+    return license_data;
+}
+
+} // namespace
+
+std::string LicenseManager::generate_license(const LicenseInfo& info) const {
+    auto license_data = license_fields(info, pimpl_->hmac_validator_.signing_key_id());
+    
     try {
-        std::unordered_map<std::string, json::JsonValue> license_data;
-        
-        license_data["user_id"] = info.user_id;
-        license_data["license_id"] = info.license_id;
-        license_data["expiry"] = format_iso8601(info.expiry);
-        license_data["issued_at"] = format_iso8601(info.issued_at);
-        license_data["hardware_hash"] = info.hardware_hash;
-        license_data["features"] = info.features;
-        license_data["version"] = std::to_string(info.version);
-        
         // Sign the license
         std::string data_to_sign = json::SimpleJson::stringify(license_data);
         std::string signature = pimpl_->hmac_validator_.sign(data_to_sign);
@@ -226,33 +435,63 @@ std::string LicenseManager::generate_license(const LicenseInfo& info) const {
     }
 }
 
+std::string LicenseManager::generate_detached_license(const LicenseInfo& info) const {
+    auto license_data = license_fields(info, pimpl_->hmac_validator_.signing_key_id());
+    
+    try {
+        // The envelope MAC covers these exact bytes; no canonical form is needed
+        return pimpl_->hmac_validator_.seal_envelope(json::SimpleJson::stringify(license_data));
+        
+    } catch (const std::exception& e) {
+        throw ValidationException("Failed to generate license: " + std::string(e.what()));
+    }
+}
+
+std::string LicenseManager::generate_binary_license(const LicenseInfo& info) const {
+    return binary_license_from_json(generate_license(info));
+}
+
+std::string LicenseManager::binary_license_from_json(const std::string& license_json) {
+    return binary::from_json(license_json);
+}
+
+std::string LicenseManager::json_license_from_binary(const std::string& binary_license) {
+    return binary::to_json(binary_license);
+}
+
 bool LicenseManager::is_expired() const {
-    if (!pimpl_->current_license_.valid) {
-        if (pimpl_->strict_validation_) {
-            throw ValidationException("No valid license loaded");
+    std::chrono::system_clock::time_point expiry;
+    {
+        LicenseSnapshot::ReadGuard license(pimpl_->current_license_);
+        if (!license->valid) {
+            if (pimpl_->strict_validation_) {
+                throw ValidationException("No valid license loaded");
+            }
+            return true;
         }
-        return true;
+        expiry = license->expiry;
     }
     
     auto now = std::chrono::system_clock::now();
-    bool expired = now > pimpl_->current_license_.expiry;
+    bool expired = now > expiry;
     
     if (expired && pimpl_->strict_validation_) {
-        throw ExpiredLicenseException(format_iso8601(pimpl_->current_license_.expiry));
+        throw ExpiredLicenseException(format_iso8601(expiry));
     }
     
     return expired;
 }
 
 std::vector<std::string> LicenseManager::get_available_features() const {
-    if (!pimpl_->current_license_.valid) {
+    LicenseSnapshot::ReadGuard license(pimpl_->current_license_);
+    if (!license->valid) {
         if (pimpl_->strict_validation_) {
             throw ValidationException("No valid license loaded");
         }
         return {};
     }
     
-    return pimpl_->current_license_.features;
+    return license->features;
 }
 
 std::string LicenseManager::get_current_hwid() const {
@@ -268,6 +507,7 @@ void LicenseManager::set_hardware_config(const HardwareConfig& config) {
         pimpl_->hardware_config_ = config;
         // Recreate fingerprint object with new config
         pimpl_->hardware_fingerprint_ = std::make_unique<HardwareFingerprint>(config);
+        pimpl_->flush_validation_cache();
     } catch (const std::exception& e) {
         throw HardwareDetectionException("Failed to set hardware config: " + std::string(e.what()));
     }
@@ -277,62 +517,75 @@ void LicenseManager::set_strict_validation(bool strict) {
     pimpl_->strict_validation_ = strict;
 }
 
-// Helper functions for date parsing/formatting
-std::chrono::system_clock::time_point LicenseManager::parse_iso8601(const std::string& date_str) {
-    if (date_str.empty()) {
-        throw std::invalid_argument("Date string cannot be empty");
-    }
-
-    auto parse_with_format = [&date_str](const char* format, bool allow_z, std::tm& out_tm) -> bool {
-        out_tm = {};
-        std::istringstream ss(date_str);
-        ss >> std::get_time(&out_tm, format);
-        if (ss.fail()) {
-            return false;
-        }
-
-        ss >> std::ws;
-        if (allow_z && ss.peek() == 'Z') {
-            ss.get();
-            ss >> std::ws;
-        }
+void LicenseManager::add_key(const std::string& kid, const std::string& secret_key) {
+    pimpl_->hmac_validator_.add_key(kid, secret_key);
+    pimpl_->flush_validation_cache();
+}
 
-        if (!ss.eof()) {
-            throw std::invalid_argument("Invalid date format: " + date_str);
-        }
+bool LicenseManager::remove_key(const std::string& kid) {
+    bool removed = pimpl_->hmac_validator_.remove_key(kid);
+    if (removed) {
+        pimpl_->flush_validation_cache();
+    }
+    return removed;
+}
 
-        return true;
-    };
+void LicenseManager::set_signing_key(const std::string& kid) {
+    pimpl_->hmac_validator_.set_signing_key(kid);
+}
 
-    std::tm tm{};
-    if (!parse_with_format("%Y-%m-%dT%H:%M:%S", true, tm) &&
-        !parse_with_format("%Y-%m-%d", false, tm)) {
-        throw std::invalid_argument("Invalid date format: " + date_str);
+void LicenseManager::set_validation_cache(const ValidationCacheConfig& config) {
+    if (config.enabled && config.capacity > 0) {
+        pimpl_->validation_cache_ = std::make_unique<LicenseCache>(config.capacity, config.shards);
+    } else {
+        pimpl_->validation_cache_.reset();
     }
+}
 
-    const auto time_t = to_utc_time_t(&tm);
-    if (time_t == static_cast<std::time_t>(-1)) {
-        throw std::invalid_argument("Invalid date: " + date_str);
-    }
+void LicenseManager::clear_validation_cache() {
+    pimpl_->flush_validation_cache();
+}
 
-    return std::chrono::system_clock::from_time_t(time_t);
+ValidationCacheStats LicenseManager::get_validation_cache_stats() const {
+    return pimpl_->validation_cache_ ? pimpl_->validation_cache_->stats() : ValidationCacheStats{};
 }
 
-std::string LicenseManager::format_iso8601(const std::chrono::system_clock::time_point& time_point) {
-    auto time_t = std::chrono::system_clock::to_time_t(time_point);
-    const std::tm tm = gmtime_safe(time_t);
+// Helper functions for date parsing/formatting
+std::chrono::system_clock::time_point LicenseManager::parse_iso8601(const std::string& date_str) {
+    return iso8601::parse(date_str);
+}
 
-    std::ostringstream ss;
-    ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
-    return ss.str();
+std::string LicenseManager::format_iso8601(const std::chrono::system_clock::time_point& time_point) {
+    return iso8601::format(time_point);
 }
 
 bool LicenseManager::validate_license(const std::string& license_json, const std::string& hardware_id) const {
+    // Same checks as load_and_validate, but nothing is published or cached:
+    // safe to call from many threads at once, alongside reloads. The machine
+    // is probed once; check then compares the license against hardware_id.
+    std::string hwid;
+    try {
+        pimpl_->probe_hwid(hwid);
+    } catch (const HardwareDetectionException&) {
+        return false;
+    }
+    // The license must name both hardware_id and this machine
+    if (hwid != hardware_id) {
+        return false;
+    }
+    
+    if (pimpl_->validation_cache_) {
+        LicenseInfo cached;
+        if (pimpl_->validation_cache_->lookup(license_json, cached)) {
+            return cached.valid && cached.hardware_hash == hardware_id;
+        }
+    }
+    
+    // A rejected license is an error code; only malformed input throws
     try {
-        // Create a temporary non-const copy to call load_and_validate
-        LicenseManager* non_const_this = const_cast<LicenseManager*>(this);
-        LicenseInfo info = non_const_this->load_and_validate(license_json);
-        return info.hardware_hash == hardware_id && info.valid;
+        json::JsonDocumentView document;
+        decoder::DecodedLicense decoded;
+        return pimpl_->check(license_json, document, decoded, hwid) == Impl::CheckError::None;
     } catch (const LicenseException&) {
         return false;
     }
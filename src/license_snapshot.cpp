@@ -0,0 +1,19 @@
+#include "license_snapshot.hpp"
+#include <thread>
+
+namespace license_core {
+
+void LicenseSnapshot::wait_for_readers() {
+    // A reader that loaded the old pointer registered before the exchange, on
+    // either parity; after both have drained once, none is left
+    for (int flip = 0; flip < 2; ++flip) {
+        const unsigned old_parity = epoch_.fetch_add(1) & 1;
+        for (Slot& slot : slots_) {
+            while (slot.readers[old_parity].load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+} // namespace license_core
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "license_core/license_manager.hpp"
+#include "feature_set.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace license_core {
+
+// The active license, published RCU-style: readers take a snapshot with a
+// fixed number of atomic operations (wait-free, no locks, no shared reference
+// count), and a reload fills a spare copy, swaps it in and waits for readers
+// of the old one to leave before reusing it. Two copies, each with its
+// features compiled into a FeatureSet, are kept and reused, so a steady-state
+// reload does not allocate.
+//
+// Readers register in one of READER_SLOTS counters, chosen per thread, under
+// the current epoch parity. The writer flips the parity twice and waits for
+// each side to drain (the liburcu grace period), after which no reader can
+// still see the old copy. One writer at a time.
+class LicenseSnapshot {
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> readers[2] = {};
+    };
+
+    struct Copy {
+        LicenseInfo info;
+        FeatureSet features; // compiled from info.features
+    };
+
+public:
+    static constexpr size_t READER_SLOTS = 64;
+
+    LicenseSnapshot() = default;
+
+    LicenseSnapshot(const LicenseSnapshot&) = delete;
+    LicenseSnapshot& operator=(const LicenseSnapshot&) = delete;
+
+    // Pins the current license for its lifetime; keep it short, a reload
+    // waits for it
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const LicenseSnapshot& owner) noexcept
+            : slot_(&owner.slots_[reader_slot()]) {
+            parity_ = owner.epoch_.load() & 1;
+            slot_->readers[parity_].fetch_add(1);
+            copy_ = owner.current_.load();
+        }
+        ~ReadGuard() { slot_->readers[parity_].fetch_sub(1, std::memory_order_release); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const LicenseInfo& operator*() const noexcept { return copy_->info; }
+        const LicenseInfo* operator->() const noexcept { return &copy_->info; }
+        const FeatureSet& features() const noexcept { return copy_->features; }
+
+    private:
+        Slot* slot_;
+        unsigned parity_;
+        const Copy* copy_;
+    };
+
+    // fill(LicenseInfo& next) writes the new license into the spare copy,
+    // which still holds the license before last, so its capacity is reused
+    template <typename Fill>
+    void publish(Fill&& fill) {
+        fill(spare_->info);
+        spare_->features.build(spare_->info.features);
+        spare_ = const_cast<Copy*>(current_.exchange(spare_));
+        wait_for_readers();
+    }
+
+    // The published license, for the writer thread only
+    const LicenseInfo& latest() const noexcept { return current_.load(std::memory_order_relaxed)->info; }
+    const FeatureSet& latest_features() const noexcept { return current_.load(std::memory_order_relaxed)->features; }
+
+private:
+    static size_t reader_slot() noexcept {
+        // Round robin, so up to READER_SLOTS threads never share a counter
+        static std::atomic<size_t> next_slot{0};
+        thread_local const size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+        return slot;
+    }
+
+    void wait_for_readers();
+
+    Copy copies_[2];
+    std::atomic<const Copy*> current_{&copies_[0]};
+    Copy* spare_ = &copies_[1];
+    std::atomic<uint32_t> epoch_{0};
+    mutable Slot slots_[READER_SLOTS];
+};
+
+} // namespace license_core
@@ -0,0 +1,85 @@
+#include "simd/cpu_features.hpp"
+
+#if defined(LICENSECORE_X86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace license_core {
+namespace simd {
+
+namespace {
+
+#if defined(LICENSECORE_X86)
+
+void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<unsigned int>(out[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// AVX state must be enabled by the OS, not just supported by the CPU
+bool os_saves_ymm() {
+#if defined(_MSC_VER)
+    return (_xgetbv(0) & 0x6) == 0x6;
+#else
+    unsigned int eax = 0;
+    unsigned int edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (eax & 0x6) == 0x6;
+#endif
+}
+
+CpuFeatures detect() {
+    CpuFeatures features;
+    unsigned int regs[4] = {0, 0, 0, 0};
+
+    cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+    if (max_leaf < 1) {
+        return features;
+    }
+
+    cpuid(1, 0, regs);
+    features.sse2 = (regs[3] & (1u << 26)) != 0;
+    features.ssse3 = (regs[2] & (1u << 9)) != 0;
+    features.sse41 = (regs[2] & (1u << 19)) != 0;
+    features.sse42 = (regs[2] & (1u << 20)) != 0;
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool avx = (regs[2] & (1u << 28)) != 0;
+
+    if (max_leaf >= 7) {
+        cpuid(7, 0, regs);
+        features.avx2 = avx && osxsave && os_saves_ymm() && (regs[1] & (1u << 5)) != 0;
+        features.sha = features.sse41 && (regs[1] & (1u << 29)) != 0;
+    }
+
+    return features;
+}
+
+#else
+
+CpuFeatures detect() {
+    return CpuFeatures{};
+}
+
+#endif
+
+} // namespace
+
+const CpuFeatures& cpu_features() noexcept {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+} // namespace simd
+} // namespace license_core
@@ -0,0 +1,33 @@
+#pragma once
+
+// Runtime CPU feature detection for the SIMD fast paths.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LICENSECORE_X86 1
+#endif
+
+// Per-function instruction set enabling, so the rest of the library keeps the
+// baseline ISA and SIMD kernels are only reached after a runtime check.
+#if defined(LICENSECORE_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define LICENSECORE_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define LICENSECORE_TARGET(isa)
+#endif
+
+namespace license_core {
+namespace simd {
+
+struct CpuFeatures {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool avx2 = false;
+    bool sha = false;
+};
+
+// Detected once on first use; always all-false on non-x86 targets
+const CpuFeatures& cpu_features() noexcept;
+
+} // namespace simd
+} // namespace license_core
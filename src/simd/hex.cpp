@@ -0,0 +1,236 @@
+#include "simd/hex.hpp"
+#include "simd/cpu_features.hpp"
+
+#if defined(LICENSECORE_X86)
+#include <immintrin.h>
+#endif
+
+namespace license_core {
+namespace simd {
+
+namespace {
+
+// Two output characters per byte value, so encoding is one 16-bit copy per byte
+struct EncodeTable {
+    char pairs[256][2];
+    constexpr EncodeTable() : pairs() {
+        const char digits[] = "0123456789abcdef";
+        for (int i = 0; i < 256; ++i) {
+            pairs[i][0] = digits[i >> 4];
+            pairs[i][1] = digits[i & 0x0F];
+        }
+    }
+};
+
+// Nibble value per character, -1 for non-hex
+struct DecodeTable {
+    int8_t values[256];
+    constexpr DecodeTable() : values() {
+        for (int i = 0; i < 256; ++i) {
+            values[i] = -1;
+        }
+        for (int i = 0; i < 10; ++i) {
+            values['0' + i] = static_cast<int8_t>(i);
+        }
+        for (int i = 0; i < 6; ++i) {
+            values['a' + i] = static_cast<int8_t>(10 + i);
+            values['A' + i] = static_cast<int8_t>(10 + i);
+        }
+    }
+};
+
+constexpr EncodeTable ENCODE_TABLE;
+constexpr DecodeTable DECODE_TABLE;
+
+using EncodeFn = void (*)(const uint8_t*, size_t, char*) noexcept;
+using DecodeFn = bool (*)(const char*, size_t, uint8_t*) noexcept;
+
+EncodeFn select_encode() {
+    const auto& cpu = cpu_features();
+    return cpu.avx2 ? detail::hex_encode_avx2
+         : cpu.ssse3 ? detail::hex_encode_ssse3
+                     : detail::hex_encode_scalar;
+}
+
+DecodeFn select_decode() {
+    const auto& cpu = cpu_features();
+    return cpu.avx2 ? detail::hex_decode_avx2
+         : cpu.ssse3 ? detail::hex_decode_ssse3
+                     : detail::hex_decode_scalar;
+}
+
+} // namespace
+
+void hex_encode(const uint8_t* bytes, size_t length, char* out) noexcept {
+    static const EncodeFn encode = select_encode();
+    encode(bytes, length, out);
+}
+
+bool hex_decode(const char* hex, size_t length, uint8_t* out) noexcept {
+    static const DecodeFn decode = select_decode();
+    return decode(hex, length, out);
+}
+
+namespace detail {
+
+void hex_encode_scalar(const uint8_t* bytes, size_t length, char* out) noexcept {
+    for (size_t i = 0; i < length; ++i) {
+        const char* pair = ENCODE_TABLE.pairs[bytes[i]];
+        out[2 * i] = pair[0];
+        out[2 * i + 1] = pair[1];
+    }
+}
+
+bool hex_decode_scalar(const char* hex, size_t length, uint8_t* out) noexcept {
+    // OR the table values together so the loop has no early exit per byte
+    int8_t invalid = 0;
+    for (size_t i = 0; i < length; ++i) {
+        int8_t hi = DECODE_TABLE.values[static_cast<uint8_t>(hex[2 * i])];
+        int8_t lo = DECODE_TABLE.values[static_cast<uint8_t>(hex[2 * i + 1])];
+        invalid |= hi | lo;
+        out[i] = static_cast<uint8_t>(((hi & 0x0F) << 4) | (lo & 0x0F));
+    }
+    return invalid >= 0;
+}
+
+#if defined(LICENSECORE_X86)
+
+namespace {
+
+// 16 bytes -> 32 characters: split nibbles, map through a pshufb digit table, interleave
+LICENSECORE_TARGET("ssse3")
+inline void encode16(const uint8_t* bytes, char* out) {
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                         '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), low_mask));
+    __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, low_mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(hi, lo));
+}
+
+// 16 characters -> 16 nibble values; valid is all-ones per byte that was a hex digit.
+// Unsigned x <= n is tested as min(x, n) == x.
+LICENSECORE_TARGET("ssse3")
+inline __m128i nibbles16(__m128i c, __m128i& valid) {
+    __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i alpha = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    valid = _mm_or_si128(is_digit, is_alpha);
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+// 32 characters -> 16 bytes; returns false on any non-hex character
+LICENSECORE_TARGET("ssse3")
+inline bool decode16(const char* hex, uint8_t* out) {
+    __m128i valid0;
+    __m128i valid1;
+    __m128i n0 = nibbles16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex)), valid0);
+    __m128i n1 = nibbles16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 16)), valid1);
+    // hi * 16 + lo for each character pair, then narrow the 16-bit sums to bytes
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(n0, weights), _mm_maddubs_epi16(n1, weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+    return _mm_movemask_epi8(_mm_and_si128(valid0, valid1)) == 0xFFFF;
+}
+
+LICENSECORE_TARGET("avx2")
+inline __m256i nibbles32(__m256i c, __m256i& valid) {
+    __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    valid = _mm256_or_si256(is_digit, is_alpha);
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                           _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+} // namespace
+
+LICENSECORE_TARGET("ssse3")
+void hex_encode_ssse3(const uint8_t* bytes, size_t length, char* out) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        encode16(bytes + i, out + 2 * i);
+    }
+    hex_encode_scalar(bytes + i, length - i, out + 2 * i);
+}
+
+LICENSECORE_TARGET("ssse3")
+bool hex_decode_ssse3(const char* hex, size_t length, uint8_t* out) noexcept {
+    bool ok = true;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        ok &= decode16(hex + 2 * i, out + i);
+    }
+    return hex_decode_scalar(hex + 2 * i, length - i, out + i) && ok;
+}
+
+LICENSECORE_TARGET("avx2")
+void hex_encode_avx2(const uint8_t* bytes, size_t length, char* out) noexcept {
+    const __m256i digits = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                            '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                            '0', '1', '2', '3', '4', '5', '6', '7',
+                                            '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+        __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, low_mask));
+        // unpack works per 128-bit lane; recombine the lane halves in byte order
+        __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    hex_encode_ssse3(bytes + i, length - i, out + 2 * i);
+}
+
+LICENSECORE_TARGET("avx2")
+bool hex_decode_avx2(const char* hex, size_t length, uint8_t* out) noexcept {
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    __m256i valid = _mm256_set1_epi8(-1);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i valid0;
+        __m256i valid1;
+        __m256i n0 = nibbles32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + 2 * i)), valid0);
+        __m256i n1 = nibbles32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + 2 * i + 32)), valid1);
+        __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(n0, weights),
+                                             _mm256_maddubs_epi16(n1, weights));
+        // packus interleaves the 128-bit lanes of its inputs; restore byte order
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+        valid = _mm256_and_si256(valid, _mm256_and_si256(valid0, valid1));
+    }
+    bool ok = _mm256_movemask_epi8(valid) == -1;
+    return hex_decode_ssse3(hex + 2 * i, length - i, out + i) && ok;
+}
+
+#else
+
+void hex_encode_ssse3(const uint8_t* bytes, size_t length, char* out) noexcept {
+    hex_encode_scalar(bytes, length, out);
+}
+
+bool hex_decode_ssse3(const char* hex, size_t length, uint8_t* out) noexcept {
+    return hex_decode_scalar(hex, length, out);
+}
+
+void hex_encode_avx2(const uint8_t* bytes, size_t length, char* out) noexcept {
+    hex_encode_scalar(bytes, length, out);
+}
+
+bool hex_decode_avx2(const char* hex, size_t length, uint8_t* out) noexcept {
+    return hex_decode_scalar(hex, length, out);
+}
+
+#endif
+
+} // namespace detail
+
+} // namespace simd
+} // namespace license_core
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Shared hex codec. Kernels write into caller-provided buffers and never
+// allocate; an SSSE3 or AVX2 path is picked once at runtime, with a
+// table-driven scalar fallback for short tails and other targets.
+namespace license_core {
+namespace simd {
+
+// Write 2 * length lowercase hex characters to out (no terminator)
+void hex_encode(const uint8_t* bytes, size_t length, char* out) noexcept;
+
+// Decode 2 * length hex characters (either case) into length bytes.
+// Returns false if any character is not a hex digit; out is then unspecified.
+bool hex_decode(const char* hex, size_t length, uint8_t* out) noexcept;
+
+inline std::string hex_encode(const uint8_t* bytes, size_t length) {
+    std::string hex(length * 2, '\0');
+    hex_encode(bytes, length, &hex[0]);
+    return hex;
+}
+
+namespace detail {
+
+void hex_encode_scalar(const uint8_t* bytes, size_t length, char* out) noexcept;
+bool hex_decode_scalar(const char* hex, size_t length, uint8_t* out) noexcept;
+void hex_encode_ssse3(const uint8_t* bytes, size_t length, char* out) noexcept;
+bool hex_decode_ssse3(const char* hex, size_t length, uint8_t* out) noexcept;
+void hex_encode_avx2(const uint8_t* bytes, size_t length, char* out) noexcept;
+bool hex_decode_avx2(const char* hex, size_t length, uint8_t* out) noexcept;
+
+} // namespace detail
+
+} // namespace simd
+} // namespace license_core
@@ -0,0 +1,122 @@
+#include "simd/json_escape.hpp"
+#include "simd/cpu_features.hpp"
+#include "simd/json_index.hpp"
+
+#if defined(LICENSECORE_X86)
+#include <immintrin.h>
+#endif
+
+namespace license_core {
+namespace simd {
+
+namespace {
+
+struct EscapeSet {
+    bool needs_escape[256];
+    constexpr EscapeSet() : needs_escape() {
+        needs_escape[static_cast<unsigned char>('"')] = true;
+        needs_escape[static_cast<unsigned char>('\\')] = true;
+        needs_escape[static_cast<unsigned char>('\b')] = true;
+        needs_escape[static_cast<unsigned char>('\f')] = true;
+        needs_escape[static_cast<unsigned char>('\n')] = true;
+        needs_escape[static_cast<unsigned char>('\r')] = true;
+        needs_escape[static_cast<unsigned char>('\t')] = true;
+    }
+};
+
+constexpr EscapeSet ESCAPE_SET;
+
+using FindFn = size_t (*)(const char*, size_t) noexcept;
+
+FindFn select_find() {
+    const auto& cpu = cpu_features();
+    return cpu.avx2 ? detail::find_json_escape_avx2
+         : cpu.sse2 ? detail::find_json_escape_sse2
+                    : detail::find_json_escape_scalar;
+}
+
+} // namespace
+
+size_t find_json_escape(const char* data, size_t length) noexcept {
+    static const FindFn find = select_find();
+    return find(data, length);
+}
+
+namespace detail {
+
+size_t find_json_escape_scalar(const char* data, size_t length) noexcept {
+    for (size_t i = 0; i < length; ++i) {
+        if (ESCAPE_SET.needs_escape[static_cast<unsigned char>(data[i])]) {
+            return i;
+        }
+    }
+    return length;
+}
+
+#if defined(LICENSECORE_X86)
+
+// '"', '\' or \b..\r except \v; the range test is unsigned (c - '\b') <= 5
+// as min(x, 5) == x
+
+LICENSECORE_TARGET("sse2")
+size_t find_json_escape_sse2(const char* data, size_t length) noexcept {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i backspace = _mm_set1_epi8('\b');
+    const __m128i vtab = _mm_set1_epi8('\v');
+    const __m128i five = _mm_set1_epi8(5);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i offset = _mm_sub_epi8(v, backspace);
+        __m128i control = _mm_andnot_si128(_mm_cmpeq_epi8(v, vtab),
+                                           _mm_cmpeq_epi8(_mm_min_epu8(offset, five), offset));
+        __m128i hit = _mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                                         _mm_cmpeq_epi8(v, backslash)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+        if (mask != 0) {
+            return i + lowest_set_bit(mask);
+        }
+    }
+    return i + find_json_escape_scalar(data + i, length - i);
+}
+
+LICENSECORE_TARGET("avx2")
+size_t find_json_escape_avx2(const char* data, size_t length) noexcept {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i backspace = _mm256_set1_epi8('\b');
+    const __m256i vtab = _mm256_set1_epi8('\v');
+    const __m256i five = _mm256_set1_epi8(5);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i offset = _mm256_sub_epi8(v, backspace);
+        __m256i control = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, vtab),
+                                              _mm256_cmpeq_epi8(_mm256_min_epu8(offset, five), offset));
+        __m256i hit = _mm256_or_si256(control, _mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                                                               _mm256_cmpeq_epi8(v, backslash)));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+        if (mask != 0) {
+            return i + lowest_set_bit(mask);
+        }
+    }
+    return i + find_json_escape_sse2(data + i, length - i);
+}
+
+#else
+
+size_t find_json_escape_sse2(const char* data, size_t length) noexcept {
+    return find_json_escape_scalar(data, length);
+}
+
+size_t find_json_escape_avx2(const char* data, size_t length) noexcept {
+    return find_json_escape_scalar(data, length);
+}
+
+#endif
+
+} // namespace detail
+
+} // namespace simd
+} // namespace license_core
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+// Search for the bytes SimpleJson escapes on output: '"', '\' and the control
+// characters written as \b, \f, \n, \r and \t. Other bytes, including the
+// remaining control characters, are copied through unchanged. An SSE2 or AVX2
+// kernel is picked once at runtime, with a table-driven scalar fallback.
+namespace license_core {
+namespace simd {
+
+// Index of the first byte that needs escaping, or length if there is none
+size_t find_json_escape(const char* data, size_t length) noexcept;
+
+namespace detail {
+
+size_t find_json_escape_scalar(const char* data, size_t length) noexcept;
+size_t find_json_escape_sse2(const char* data, size_t length) noexcept;
+size_t find_json_escape_avx2(const char* data, size_t length) noexcept;
+
+} // namespace detail
+
+} // namespace simd
+} // namespace license_core
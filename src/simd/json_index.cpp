@@ -0,0 +1,162 @@
+#include "simd/json_index.hpp"
+#include "simd/cpu_features.hpp"
+#include <cstring>
+
+#if defined(LICENSECORE_X86)
+#include <immintrin.h>
+#endif
+
+namespace license_core {
+namespace simd {
+
+namespace {
+
+using ClassifyFn = void (*)(const char*, size_t, JsonBlockMasks*) noexcept;
+
+ClassifyFn select_classify() {
+    const auto& cpu = cpu_features();
+    return cpu.avx2 ? detail::classify_json_avx2
+         : cpu.sse42 ? detail::classify_json_sse42
+                     : detail::classify_json_scalar;
+}
+
+} // namespace
+
+void classify_json(const char* data, size_t length, JsonBlockMasks* out) noexcept {
+    static const ClassifyFn classify = select_classify();
+
+    const size_t full_blocks = length / JSON_BLOCK_SIZE;
+    classify(data, full_blocks, out);
+
+    // Pad the tail with spaces so the kernels only ever see whole blocks
+    const size_t tail = length % JSON_BLOCK_SIZE;
+    if (tail != 0) {
+        char block[JSON_BLOCK_SIZE];
+        std::memset(block, ' ', sizeof(block));
+        std::memcpy(block, data + full_blocks * JSON_BLOCK_SIZE, tail);
+        classify(block, 1, out + full_blocks);
+    }
+}
+
+namespace detail {
+
+void classify_json_scalar(const char* data, size_t block_count, JsonBlockMasks* out) noexcept {
+    for (size_t b = 0; b < block_count; ++b) {
+        JsonBlockMasks masks = {};
+        const char* block = data + b * JSON_BLOCK_SIZE;
+        for (unsigned i = 0; i < JSON_BLOCK_SIZE; ++i) {
+            const uint64_t bit = uint64_t(1) << i;
+            switch (block[i]) {
+                case ' ': case '\t': case '\n': case '\v': case '\f': case '\r':
+                    masks.whitespace |= bit; break;
+                case '"': case '\\':
+                    masks.string |= bit; break;
+                case ',': case ']': case '}':
+                    masks.delimiter |= bit; break;
+                default: break;
+            }
+        }
+        out[b] = masks;
+    }
+}
+
+#if defined(LICENSECORE_X86)
+
+namespace {
+
+// Bytes equal to any of the characters: plain compares ORed together, one
+// movemask per register. The SSE4.2 string instructions are slower than this
+// for small fixed sets.
+template <typename... Chars>
+LICENSECORE_TARGET("sse4.2")
+inline uint64_t any64(const __m128i v[4], Chars... chars) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i match = _mm_setzero_si128();
+        ((match = _mm_or_si128(match, _mm_cmpeq_epi8(v[i], _mm_set1_epi8(chars)))), ...);
+        mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(match))) << (16 * i);
+    }
+    return mask;
+}
+
+// ' ' or \t..\r; the range test is unsigned (c - '\t') <= 4 as min(x, 4) == x
+LICENSECORE_TARGET("sse4.2")
+inline uint64_t whitespace64(const __m128i v[4]) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i four = _mm_set1_epi8(4);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i offset = _mm_sub_epi8(v[i], tab);
+        __m128i is_space = _mm_or_si128(_mm_cmpeq_epi8(v[i], space),
+                                        _mm_cmpeq_epi8(_mm_min_epu8(offset, four), offset));
+        mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(is_space))) << (16 * i);
+    }
+    return mask;
+}
+
+template <typename... Chars>
+LICENSECORE_TARGET("avx2")
+inline uint64_t any64(__m256i lo, __m256i hi, Chars... chars) {
+    __m256i match_lo = _mm256_setzero_si256();
+    __m256i match_hi = _mm256_setzero_si256();
+    ((match_lo = _mm256_or_si256(match_lo, _mm256_cmpeq_epi8(lo, _mm256_set1_epi8(chars)))), ...);
+    ((match_hi = _mm256_or_si256(match_hi, _mm256_cmpeq_epi8(hi, _mm256_set1_epi8(chars)))), ...);
+    uint32_t low = static_cast<uint32_t>(_mm256_movemask_epi8(match_lo));
+    uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(match_hi));
+    return low | (static_cast<uint64_t>(high) << 32);
+}
+
+LICENSECORE_TARGET("avx2")
+inline uint32_t whitespace32(__m256i v) {
+    __m256i offset = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+    __m256i is_space = _mm256_or_si256(
+        _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+        _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(4)), offset));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(is_space));
+}
+
+} // namespace
+
+LICENSECORE_TARGET("sse4.2")
+void classify_json_sse42(const char* data, size_t block_count, JsonBlockMasks* out) noexcept {
+    for (size_t b = 0; b < block_count; ++b) {
+        const char* block = data + b * JSON_BLOCK_SIZE;
+        __m128i v[4];
+        for (int i = 0; i < 4; ++i) {
+            v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+        }
+        out[b].whitespace = whitespace64(v);
+        out[b].string = any64(v, '"', '\\');
+        out[b].delimiter = any64(v, ',', ']', '}');
+    }
+}
+
+LICENSECORE_TARGET("avx2")
+void classify_json_avx2(const char* data, size_t block_count, JsonBlockMasks* out) noexcept {
+    for (size_t b = 0; b < block_count; ++b) {
+        const char* block = data + b * JSON_BLOCK_SIZE;
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        out[b].whitespace = whitespace32(lo) | (static_cast<uint64_t>(whitespace32(hi)) << 32);
+        out[b].string = any64(lo, hi, '"', '\\');
+        out[b].delimiter = any64(lo, hi, ',', ']', '}');
+    }
+}
+
+#else
+
+void classify_json_sse42(const char* data, size_t block_count, JsonBlockMasks* out) noexcept {
+    classify_json_scalar(data, block_count, out);
+}
+
+void classify_json_avx2(const char* data, size_t block_count, JsonBlockMasks* out) noexcept {
+    classify_json_scalar(data, block_count, out);
+}
+
+#endif
+
+} // namespace detail
+
+} // namespace simd
+} // namespace license_core
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// First stage of the JSON scanner: classify the bytes that drive parsing,
+// 64 at a time, into one bitmask per character class. The parse loop then
+// jumps between set bits instead of testing every byte. An SSE4.2 or AVX2
+// kernel is picked once at runtime, with a scalar fallback.
+namespace license_core {
+namespace simd {
+
+// Bit i describes byte i of the block. Classes are merged the way the parser
+// searches them; it tells members of a class apart by reading the byte.
+struct JsonBlockMasks {
+    uint64_t whitespace; // ' ', \t, \n, \v, \f, \r
+    uint64_t string;     // " and \ (escape handling is left to the parser)
+    uint64_t delimiter;  // , ] }
+};
+
+constexpr size_t JSON_BLOCK_SIZE = 64;
+
+constexpr size_t json_block_count(size_t length) {
+    return (length + JSON_BLOCK_SIZE - 1) / JSON_BLOCK_SIZE;
+}
+
+// Fill json_block_count(length) blocks. Bytes past the end of the last block
+// read as whitespace, so no search ever stops there.
+void classify_json(const char* data, size_t length, JsonBlockMasks* out) noexcept;
+
+// Index of the lowest set bit; mask must be non-zero
+inline unsigned lowest_set_bit(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+namespace detail {
+
+// Whole 64-byte blocks only
+void classify_json_scalar(const char* data, size_t block_count, JsonBlockMasks* out) noexcept;
+void classify_json_sse42(const char* data, size_t block_count, JsonBlockMasks* out) noexcept;
+void classify_json_avx2(const char* data, size_t block_count, JsonBlockMasks* out) noexcept;
+
+} // namespace detail
+
+} // namespace simd
+} // namespace license_core
@@ -21,6 +21,13 @@ bool test_hmac_validator() {
     assert(!validator.verify("different data", signature));
     assert(!validator.verify(data, "wrong-signature"));
     
+    // Binary digest API agrees with the hex API
+    auto digest = validator.sign_raw(data);
+    assert(validator.verify_raw(data, digest));
+    HMACValidator::Digest decoded{};
+    assert(HMACValidator::decode_signature(signature, decoded));
+    assert(decoded == digest);
+    
     std::cout << "✅ HMAC Validator tests passed" << std::endl;
     return true;
 }
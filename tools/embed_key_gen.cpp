@@ -0,0 +1,180 @@
+// Build-time generator for the licensecore_embedded library.
+//
+//   embed_key_gen <key_file> <output.cpp> [license_file]
+//
+// Reduces the HMAC secret to its SHA-256 inner/outer midstates and writes them
+// as constant data, so the secret itself never reaches the shipped binary and
+// the key schedule is never run at startup. With a license file, the license is
+// verified here and emitted as its canonical signed payload plus decoded
+// signature, expiry and hardware hash - all lc_validate_embedded() needs.
+// A single trailing newline in the key file is ignored; see strip_final_newline.
+
+#include "license_core/hmac_validator.hpp"
+#include "json/simple_json.hpp"
+#include "iso8601.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace license_core;
+
+namespace {
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// A key file may end with one newline ("\n" or "\r\n") that is not part of
+// the secret. Nothing else is stripped: the embedded key must MAC exactly like
+// HMACValidator(secret) at runtime, trailing whitespace included.
+std::string strip_final_newline(std::string s) {
+    if (!s.empty() && s.back() == '\n') {
+        s.pop_back();
+        if (!s.empty() && s.back() == '\r') {
+            s.pop_back();
+        }
+    }
+    return s;
+}
+
+// Same parser as LicenseManager, so the build-time expiry is the one it computes
+int64_t parse_expiry(const std::string& s) {
+    try {
+        return static_cast<int64_t>(std::chrono::system_clock::to_time_t(iso8601::parse(s)));
+    } catch (const std::invalid_argument&) {
+        throw std::runtime_error("invalid expiry: " + s);
+    }
+}
+
+std::string c_string_literal(const std::string& s) {
+    std::string out = "\"";
+    char buf[8];
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c >= 0x20 && c < 0x7f) {
+            out += static_cast<char>(c);
+        } else {
+            // Octal escapes cannot swallow following hex digits
+            std::snprintf(buf, sizeof(buf), "\\%03o", c);
+            out += buf;
+        }
+    }
+    return out + "\"";
+}
+
+void write_state(std::ostream& out, const std::array<uint32_t, 8>& state) {
+    char buf[16];
+    out << "{{";
+    for (size_t i = 0; i < state.size(); ++i) {
+        std::snprintf(buf, sizeof(buf), "0x%08xu", state[i]);
+        out << (i ? ", " : "") << buf;
+    }
+    out << "}}";
+}
+
+void write_license(std::ostream& out, const HMACValidator& validator, const std::string& license_json) {
+    auto data = json::SimpleJson::parse(license_json);
+    if (json::SimpleJson::has_key(data, "kid") && !json::SimpleJson::get_string(data, "kid").empty()) {
+        throw std::runtime_error("embedded licenses must be signed with the default key (no \"kid\")");
+    }
+    if (!validator.verify_json(license_json)) {
+        throw std::runtime_error("license signature does not match the embedded key");
+    }
+
+    HMACValidator::Digest signature;
+    if (!HMACValidator::decode_signature(json::SimpleJson::get_string(data, "hmac_signature"), signature)) {
+        throw std::runtime_error("malformed hmac_signature");
+    }
+    std::string hardware_hash = json::SimpleJson::get_string(data, "hardware_hash");
+    std::vector<std::string> features = json::SimpleJson::get_string_array(data, "features");
+    int64_t expiry = parse_expiry(json::SimpleJson::get_string(data, "expiry"));
+
+    data.erase("hmac_signature");
+    std::string payload = json::SimpleJson::stringify(data);
+
+    out << "static const char* const LICENSE_FEATURES[] = {";
+    for (const auto& feature : features) {
+        out << "\n    " << c_string_literal(feature) << ",";
+    }
+    out << (features.empty() ? "nullptr};\n\n" : "\n};\n\n");
+
+    out << "static const char LICENSE_PAYLOAD[] = " << c_string_literal(payload) << ";\n\n";
+
+    out << "static const EmbeddedLicense EMBEDDED_LICENSE = {\n"
+        << "    LICENSE_PAYLOAD,\n"
+        << "    sizeof(LICENSE_PAYLOAD) - 1,\n"
+        << "    {{";
+    char buf[8];
+    for (size_t i = 0; i < signature.size(); ++i) {
+        std::snprintf(buf, sizeof(buf), "0x%02x", signature[i]);
+        out << (i ? ", " : "") << buf;
+    }
+    out << "}},\n"
+        << "    INT64_C(" << expiry << "),\n"
+        << "    " << c_string_literal(hardware_hash) << ",\n"
+        << "    LICENSE_FEATURES,\n"
+        << "    " << features.size() << "\n"
+        << "};\n\n"
+        << "const EmbeddedLicense* const LICENSE = &EMBEDDED_LICENSE;\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3 && argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " <key_file> <output.cpp> [license_file]" << std::endl;
+        return 2;
+    }
+
+    try {
+        const std::string secret = strip_final_newline(read_file(argv[1]));
+        const HMACValidator::PreparedKey key = HMACValidator::prepare_key(secret);
+        const HMACValidator validator = HMACValidator::from_prepared_key(key);
+
+        std::ostringstream out;
+        out << "// Generated by embed_key_gen - do not edit\n"
+            << "#include \"embedded/embedded_license.hpp\"\n"
+            << "#include <cstdint>\n\n"
+            << "namespace license_core {\n"
+            << "namespace embedded {\n\n"
+            << "const EmbeddedKey KEY = {\n    ";
+        write_state(out, key.inner);
+        out << ",\n    ";
+        write_state(out, key.outer);
+        out << "\n};\n\n";
+
+        if (argc == 4) {
+            write_license(out, validator, read_file(argv[3]));
+        } else {
+            out << "const EmbeddedLicense* const LICENSE = nullptr;\n";
+        }
+
+        out << "\n} // namespace embedded\n"
+            << "} // namespace license_core\n";
+
+        std::ofstream file(argv[2], std::ios::binary | std::ios::trunc);
+        if (!file || !(file << out.str())) {
+            throw std::runtime_error(std::string("cannot write ") + argv[2]);
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "embed_key_gen: " << e.what() << std::endl;
+        return 1;
+    }
+}